@@ -4,9 +4,148 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <random>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <cstring>
+#include <cctype>
+#include <cstdlib>
+#include <cmath>
+#include <cerrno>
+#include <climits>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <new>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "packed_seq.h"
 
 using namespace std;
 
+// Counter hardware per pemanggilan engine (opsional, --perf). Nilai -1 berarti
+// counter tidak tersedia / tidak diizinkan kernel.
+struct PerfCounters {
+    bool valid = false;
+    long long cycles = -1;
+    long long instructions = -1;
+    long long branchMisses = -1;
+    long long l1Misses = -1;
+    long long llcMisses = -1;
+
+    double ipc() const { return (cycles > 0 && instructions >= 0) ? (double)instructions / cycles : -1; }
+};
+
+// ==========================================
+// PELACAKAN ALOKASI (operator new/delete global)
+// ==========================================
+// Setiap alokasi heap dihitung per thread dengan ukuran sebenarnya dari
+// allocator (malloc_usable_size), jadi angka memori di tabel adalah hasil
+// ukur, bukan perkiraan dari sizeof.
+struct AllocCounters {
+    size_t allocated;   // total byte yang pernah dialokasikan
+    size_t count;       // jumlah alokasi
+    size_t live;        // byte yang masih hidup
+    size_t peak;        // puncak byte hidup
+};
+thread_local AllocCounters allocCounters = {0, 0, 0, 0};
+
+inline void* trackedAlloc(size_t size, size_t align) {
+    void* p = nullptr;
+    if (size == 0) size = 1;
+    if (align <= alignof(max_align_t)) p = malloc(size);
+    else if (posix_memalign(&p, align, size) != 0) p = nullptr;
+    if (p != nullptr) {
+        size_t real = malloc_usable_size(p);
+        allocCounters.allocated += real;
+        allocCounters.count++;
+        allocCounters.live += real;
+        if (allocCounters.live > allocCounters.peak) allocCounters.peak = allocCounters.live;
+    }
+    return p;
+}
+
+__attribute__((noinline)) void trackedFree(void* p) {
+    if (p == nullptr) return;
+    // Blok bisa dibebaskan oleh thread lain; jangan sampai live underflow
+    size_t real = malloc_usable_size(p);
+    allocCounters.live -= min(allocCounters.live, real);
+    free(p);
+}
+
+void* operator new(size_t size) {
+    void* p = trackedAlloc(size, 0);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return trackedAlloc(size, 0); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return trackedAlloc(size, 0); }
+void* operator new(size_t size, align_val_t al) {
+    void* p = trackedAlloc(size, (size_t)al);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+void* operator new[](size_t size, align_val_t al) { return operator new(size, al); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, align_val_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, align_val_t) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { trackedFree(p); }
+
+// Hasil ukur heap satu cakupan (satu pemanggilan engine / satu tabel)
+struct AllocStats {
+    size_t allocated = 0;   // byte dialokasikan selama cakupan
+    size_t peakLive = 0;    // puncak byte hidup di atas titik awal cakupan
+    size_t count = 0;       // jumlah alokasi
+    size_t retained = 0;    // byte yang masih hidup saat cakupan selesai
+};
+
+// Probe bercakupan: catat penghitung di konstruktor, baca selisihnya lewat stats()
+class MemoryProbe {
+public:
+    MemoryProbe()
+        : startAllocated(allocCounters.allocated), startCount(allocCounters.count),
+          startLive(allocCounters.live), savedPeak(allocCounters.peak) {
+        allocCounters.peak = allocCounters.live;
+    }
+    ~MemoryProbe() { allocCounters.peak = max(savedPeak, allocCounters.peak); }
+
+    AllocStats stats() const {
+        AllocStats s;
+        s.allocated = allocCounters.allocated - startAllocated;
+        s.count = allocCounters.count - startCount;
+        s.peakLive = allocCounters.peak - startLive;
+        s.retained = allocCounters.live > startLive ? allocCounters.live - startLive : 0;
+        return s;
+    }
+
+private:
+    size_t startAllocated, startCount, startLive, savedPeak;
+};
+
 struct AnalysisResult {
     string algorithm;
     long long comparisons;
@@ -15,18 +154,337 @@ struct AnalysisResult {
     
     size_t inputMem;
     size_t lpsMem;   
-    size_t stackMem; 
+    size_t stackMem;    // estimasi statis engine; diganti hasil ukur oleh measureEngine
     size_t totalMem;
+
+    PerfCounters perf = {};
+    AllocStats alloc = {};  // heap yang dialokasikan selama pemanggilan (measureEngine)
+
+    int forwardMatches = -1;    // hit untai plus / minus; hanya diisi bothStrandsSearch
+    int reverseMatches = -1;
 };
 
-size_t getStringMemory(const string& s) {
+// Teks dirujuk lewat view (bisa dari file mmap atau string milik pemanggil),
+// jadi yang dihitung adalah byte yang dibaca + view itu sendiri.
+size_t getStringMemory(string_view s) {
 
-    return sizeof(string) + (s.capacity() * sizeof(char));
+    return sizeof(string_view) + (s.size() * sizeof(char));
 
 }
 
-AnalysisResult naiveSearch(const string& text, const string& pattern) {
-    long long comparisons = 0;
+// ==========================================
+// POLA TERKOMPILASI (PREPROCESSING SEKALI)
+// ==========================================
+// Semua tabel pola (LPS, DFA, mask bit-parallel, versi 2-bit) dibangun sekali
+// per run lalu dipakai bersama lewat const reference oleh setiap engine,
+// sehingga loop per record tidak lagi membangun ulang tabel yang sama.
+vector<int> computeLPS(string_view pattern, long long& comparisons) {
+    int m = pattern.length();
+    vector<int> lps(m);
+    if (m == 0) return lps;
+    int len = 0;
+    lps[0] = 0;
+    int i = 1;
+
+    while (i < m) {
+        comparisons++; 
+        if (pattern[i] == pattern[len]) {
+            len++;
+            lps[i] = len;
+            i++;
+        } else {
+            if (len != 0) {
+                len = lps[len - 1];
+            } else {
+                lps[i] = 0;
+                i++;
+            }
+        }
+    }
+    return lps;
+}
+
+// Kode simbol DFA: A,C,G,T = 0..3, simbol lain = 4
+const int DFA_SYMBOLS = 5;
+
+struct DfaCodeTable {
+    uint8_t code[256];
+    DfaCodeTable() {
+        for (int c = 0; c < 256; c++) code[c] = 4;
+        code[(unsigned char)'A'] = 0;
+        code[(unsigned char)'C'] = 1;
+        code[(unsigned char)'G'] = 2;
+        code[(unsigned char)'T'] = 3;
+    }
+};
+const DfaCodeTable dfaCodes;
+
+vector<int32_t> buildKmpDfa(string_view pattern, const vector<int>& lps) {
+    int m = pattern.length();
+    vector<int32_t> dfa((size_t)(m + 1) * DFA_SYMBOLS, 0);
+    for (int j = 0; j <= m; j++) {
+        for (int c = 0; c < 4; c++) {
+            if (j < m && dfaCodes.code[(unsigned char)pattern[j]] == c) dfa[j * DFA_SYMBOLS + c] = j + 1;
+            else if (j > 0) dfa[j * DFA_SYMBOLS + c] = dfa[lps[j - 1] * DFA_SYMBOLS + c];
+        }
+    }
+    return dfa;
+}
+
+// Mask bit-parallel multi-word (64 bit per word) untuk Shift-And, BNDM dan
+// Myers. Setiap karakter berbeda di pola mendapat mask sendiri; karakter yang
+// tidak ada di pola memetakan ke mask nol (simbol 0).
+struct BitMasks {
+    size_t words = 0;
+    uint8_t symbol[256];
+    vector<uint64_t> masks;     // (jumlah simbol) x words
+    size_t heapBytes = 0;       // diukur saat dibangun
+
+    const uint64_t* maskFor(unsigned char c) const { return masks.data() + symbol[c] * words; }
+    size_t memory() const { return sizeof(BitMasks) + heapBytes; }
+};
+
+// Panjang faktor yang dipindai BNDM (satu word); sisa pola diverifikasi
+const size_t BNDM_FACTOR = 64;
+
+// reversed = true untuk BNDM: bit (m-1-i) di-set untuk pattern[i]
+BitMasks buildBitMasks(string_view pattern, bool reversed) {
+    BitMasks bm;
+    size_t m = pattern.length();
+    bm.words = (m + 63) / 64;
+    memset(bm.symbol, 0, sizeof(bm.symbol));
+    int symbols = 1;
+    for (char c : pattern) {
+        if (bm.symbol[(unsigned char)c] == 0) bm.symbol[(unsigned char)c] = symbols++;
+    }
+    MemoryProbe probe;
+    bm.masks.assign(symbols * bm.words, 0);
+    bm.heapBytes = probe.stats().retained;
+    for (size_t i = 0; i < m; i++) {
+        size_t bit = reversed ? (m - 1 - i) : i;
+        bm.masks[bm.symbol[(unsigned char)pattern[i]] * bm.words + bit / 64] |= 1ULL << (bit % 64);
+    }
+    return bm;
+}
+
+// Faktorisasi kritis Two-Way (Crochemore-Perrin): pola = x[0..critical] x[critical+1..m-1].
+// Hanya tiga nilai, jadi memori tambahan engine Two-Way konstan.
+struct TwoWayPlan {
+    long long critical = -1;
+    size_t period = 1;
+    bool periodic = false;      // x[0..critical] berulang dengan periode 'period'
+};
+
+// Suffix maksimal menurut urutan leksikografis (reversed = urutan terbalik);
+// kembalikan indeks awal - 1 dan periodenya
+long long twoWayMaxSuffix(string_view x, bool reversed, size_t& period) {
+    long long ms = -1;
+    size_t j = 0, k = 1;
+    size_t m = x.length();
+    period = 1;
+    while (j + k < m) {
+        unsigned char a = x[j + k];
+        unsigned char b = x[ms + k];
+        if (reversed ? a > b : a < b) {
+            j += k;
+            k = 1;
+            period = j - ms;
+        } else if (a == b) {
+            if (k != period) k++;
+            else {
+                j += period;
+                k = 1;
+            }
+        } else {
+            ms = j;
+            j = ms + 1;
+            k = period = 1;
+        }
+    }
+    return ms;
+}
+
+TwoWayPlan buildTwoWayPlan(string_view x) {
+    TwoWayPlan plan;
+    if (x.empty()) return plan;
+    size_t p, q;
+    long long i = twoWayMaxSuffix(x, false, p);
+    long long j = twoWayMaxSuffix(x, true, q);
+    plan.critical = max(i, j);
+    plan.period = (i > j) ? p : q;
+    size_t m = x.length();
+    plan.periodic = plan.period + plan.critical + 1 <= m
+                 && memcmp(x.data(), x.data() + plan.period, plan.critical + 1) == 0;
+    if (!plan.periodic) plan.period = max<size_t>(plan.critical + 1, m - plan.critical - 1) + 1;
+    return plan;
+}
+
+// Statistik pola untuk dispatcher otomatis
+struct PatternProfile {
+    size_t length = 0;
+    size_t period = 0;      // periode terkecil = m - lps[m-1]
+    size_t periodicRun = 0; // prefix/suffix periodik terpanjang, mis. 3000 untuk (CAG)^1000 + T
+    double skew = 0;        // frekuensi simbol terbanyak / m (0.25 = seragam ACGT)
+
+    // Hampir periodik juga dihitung: run berulang panjang yang menutup separuh
+    // pola membuat BNDM memverifikasi hampir setiap jendela di teks berulang.
+    // Run pendek (mis. "AA" di pola 4 basa) diabaikan, SIMD tetap lebih cepat di sana.
+    static const size_t MIN_PERIODIC_RUN = 32;
+
+    bool periodic() const {
+        if (length == 0) return false;
+        return 2 * period <= length || (periodicRun >= MIN_PERIODIC_RUN && 2 * periodicRun >= length);
+    }
+};
+
+// Prefix terpanjang pattern[0..L) dengan periode <= L/2, dibaca langsung dari LPS
+size_t longestPeriodicPrefix(const vector<int>& lps) {
+    size_t run = 0;
+    for (size_t i = 0; i < lps.size(); i++) {
+        size_t prefix = i + 1;
+        if (2 * (prefix - lps[i]) <= prefix) run = prefix;
+    }
+    return run;
+}
+
+struct CompiledPattern {
+    string text;
+    vector<int> lps;
+    vector<int32_t> dfa;            // kosong jika pola berisi simbol non-ACGT
+    BitMasks forwardMasks;          // Shift-And, Myers
+    BitMasks reverseMasks;          // BNDM (prefix maksimal 64 basa)
+    PackedSeq packed;
+    TwoWayPlan twoWay;
+    PatternProfile profile;
+    long long comparisons = 0;      // perbandingan saat membangun LPS
+    double buildTime = 0;           // ms
+
+    // Byte heap hasil ukur MemoryProbe saat kompilasi
+    size_t lpsHeap = 0;
+    size_t dfaHeap = 0;
+    size_t heapBytes = 0;           // seluruh tabel + salinan teks pola
+
+    size_t lpsMemory() const { return sizeof(vector<int>) + lpsHeap; }
+    size_t dfaMemory() const { return sizeof(vector<int32_t>) + dfaHeap; }
+    size_t memory() const { return sizeof(CompiledPattern) + heapBytes; }
+};
+
+CompiledPattern compilePattern(string_view pattern) {
+    CompiledPattern cp;
+    MemoryProbe total;
+    auto start = chrono::high_resolution_clock::now();
+
+    cp.text = string(pattern);
+    {
+        MemoryProbe probe;
+        cp.lps = computeLPS(pattern, cp.comparisons);
+        cp.lpsHeap = probe.stats().retained;
+    }
+    bool acgtOnly = true;
+    for (char c : pattern) acgtOnly = acgtOnly && dfaCodes.code[(unsigned char)c] != 4;
+    if (acgtOnly) {
+        MemoryProbe probe;
+        cp.dfa = buildKmpDfa(pattern, cp.lps);
+        cp.dfaHeap = probe.stats().retained;
+    }
+    cp.forwardMasks = buildBitMasks(pattern, false);
+    cp.reverseMasks = buildBitMasks(pattern.substr(0, BNDM_FACTOR), true);
+    cp.packed = packSequence(pattern);
+    cp.twoWay = buildTwoWayPlan(pattern);
+
+    cp.profile.length = pattern.length();
+    if (!pattern.empty()) {
+        cp.profile.period = pattern.length() - cp.lps.back();
+        long long reverseComparisons = 0;
+        string reversed(pattern.rbegin(), pattern.rend());
+        cp.profile.periodicRun = max(longestPeriodicPrefix(cp.lps),
+                                     longestPeriodicPrefix(computeLPS(reversed, reverseComparisons)));
+        size_t counts[256] = {0};
+        for (char c : pattern) counts[(unsigned char)c]++;
+        cp.profile.skew = (double)*max_element(counts, counts + 256) / pattern.length();
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    cp.heapBytes = total.stats().retained;
+    chrono::duration<double, milli> elapsed = end - start;
+    cp.buildTime = elapsed.count();
+    return cp;
+}
+
+// ==========================================
+// MATCH SINK (PELAPORAN POSISI)
+// ==========================================
+// Engine melaporkan posisi awal setiap match (64-bit) ke sink opsional; tanpa
+// sink (nullptr) engine hanya menghitung. Ketiga sink di bawah tidak pernah
+// mengalokasi heap saat report().
+class MatchSink {
+public:
+    virtual ~MatchSink() {}
+    virtual void report(uint64_t pos) = 0;
+};
+
+// Kapasitas tetap N: menyimpan N posisi terakhir, total tetap dihitung
+template <size_t N>
+class RingBufferSink : public MatchSink {
+public:
+    void report(uint64_t pos) override { slots[total++ % N] = pos; }
+
+    uint64_t count() const { return total; }
+    size_t size() const { return total < N ? (size_t)total : N; }
+    uint64_t operator[](size_t i) const { return slots[(total - size() + i) % N]; }   // 0 = tertua
+    void clear() { total = 0; }
+
+private:
+    array<uint64_t, N> slots;
+    uint64_t total = 0;
+};
+
+// Buffer milik pemanggil; posisi yang tidak muat dihitung di dropped() dan overflow() = true
+class SpanSink : public MatchSink {
+public:
+    SpanSink(uint64_t* out, size_t capacity) : out(out), capacity(capacity) {}
+
+    void report(uint64_t pos) override {
+        if (used < capacity) out[used++] = pos;
+        else droppedCount++;
+    }
+
+    size_t size() const { return used; }
+    const uint64_t* data() const { return out; }
+    bool overflow() const { return droppedCount > 0; }
+    uint64_t dropped() const { return droppedCount; }
+    void clear() {
+        used = 0;
+        droppedCount = 0;
+    }
+
+private:
+    uint64_t* out;
+    size_t capacity;
+    size_t used = 0;
+    uint64_t droppedCount = 0;
+};
+
+// Kebijakan statistik untuk engine bertemplate. CountingStats menghitung setiap
+// perbandingan untuk laporan analisis; NoStats kosong sehingga compiler membuang
+// counter dari loop terdalam (jalur produksi). Comp. = -1 berarti tidak dihitung.
+struct CountingStats {
+    static constexpr bool enabled = true;
+    long long count = 0;
+    void compare() { count++; }
+    long long comparisons() const { return count; }
+};
+
+struct NoStats {
+    static constexpr bool enabled = false;
+    void compare() {}
+    long long comparisons() const { return -1; }
+};
+
+template <typename Stats>
+AnalysisResult naiveSearchT(string_view text, const CompiledPattern& cp, MatchSink* sink) {
+    string_view pattern = cp.text;
+    Stats stats;
     int matches = 0;
     int n = text.length();
     int m = pattern.length();
@@ -45,64 +503,53 @@ AnalysisResult naiveSearch(const string& text, const string& pattern) {
     for (int i = 0; i <= n - m; i++) {
         int j;
         for (j = 0; j < m; j++) {
-            comparisons++; 
+            stats.compare();
             if (text[i + j] != pattern[j])
                 break;
         }
-        if (j == m) matches++;
+        if (j == m) {
+            matches++;
+            if (sink) sink->report(i);
+        }
     }
 
     auto end = chrono::high_resolution_clock::now();
     chrono::duration<double, milli> elapsed = end - start;
 
-    return {"Naive", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+    return {Stats::enabled ? "Naive" : "NaiveFast", stats.comparisons(), elapsed.count(), matches,
+            inputMem, lpsMem, stackMem, totalMem};
 }
 
-vector<int> computeLPS(const string& pattern, long long& comparisons) {
-    int m = pattern.length();
-    vector<int> lps(m);
-    int len = 0;
-    lps[0] = 0;
-    int i = 1;
-
-    while (i < m) {
-        comparisons++; 
-        if (pattern[i] == pattern[len]) {
-            len++;
-            lps[i] = len;
-            i++;
-        } else {
-            if (len != 0) {
-                len = lps[len - 1];
-            } else {
-                lps[i] = 0;
-                i++;
-            }
-        }
-    }
-    return lps;
+AnalysisResult naiveSearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    return naiveSearchT<CountingStats>(text, cp, sink);
+}
+AnalysisResult naiveSearchFast(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    return naiveSearchT<NoStats>(text, cp, sink);
 }
 
-AnalysisResult kmpSearch(const string& text, const string& pattern) {
-    long long comparisons = 0;
+
+template <typename Stats>
+AnalysisResult kmpSearchT(string_view text, const CompiledPattern& cp, MatchSink* sink) {
+    string_view pattern = cp.text;
+    const vector<int>& lps = cp.lps;
+    Stats stats;
     int matches = 0;
     int n = text.length();
     int m = pattern.length();
 
     auto start = chrono::high_resolution_clock::now();
 
-    vector<int> lps = computeLPS(pattern, comparisons);
-
     int i = 0; 
     int j = 0; 
-    while (i < n) {
-        comparisons++;
+    while (m > 0 && i < n) {
+        stats.compare();
         if (pattern[j] == text[i]) {
             i++;
             j++;
         }
         if (j == m) {
             matches++;
+            if (sink) sink->report(i - m);
             j = lps[j - 1];
         } else if (i < n && pattern[j] != text[i]) {
             if (j != 0) {
@@ -117,92 +564,4083 @@ AnalysisResult kmpSearch(const string& text, const string& pattern) {
     chrono::duration<double, milli> elapsed = end - start;
 
     size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
-    size_t lpsMem = sizeof(vector<int>) + (lps.capacity() * sizeof(int));
+    size_t lpsMem = cp.lpsMemory();
     size_t stackMem = (5 * sizeof(int)) + sizeof(long long);
     size_t totalMem = inputMem + lpsMem + stackMem;
 
-    return {"KMP", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+    return {Stats::enabled ? "KMP" : "KMPFast", stats.comparisons(), elapsed.count(), matches,
+            inputMem, lpsMem, stackMem, totalMem};
 }
 
-void runAnalysis(int limit) {
-    ifstream file("human.txt"); 
-    if (!file.is_open()) {
-        cout << "Error: File human.txt tidak ditemukan!" << endl;
-        return;
+AnalysisResult kmpSearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    return kmpSearchT<CountingStats>(text, cp, sink);
+}
+AnalysisResult kmpSearchFast(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    return kmpSearchT<NoStats>(text, cp, sink);
+}
+
+// KMP yang bisa dilanjutkan: state j dan offset 64-bit dibawa antar buffer, jadi
+// teks boleh datang dalam potongan berukuran berapa pun (file, pipe, generator)
+// dan match yang melintasi batas potongan tetap ditemukan. Memori = tabel LPS
+// milik CompiledPattern + buffer pemanggil.
+class StreamingKmp {
+public:
+    explicit StreamingKmp(const CompiledPattern& cp) : pattern(cp.text), lps(cp.lps) {}
+
+    // onMatch(posisiAwal) dipanggil untuk setiap kemunculan, posisi absolut di stream
+    template <typename OnMatch>
+    void feed(string_view chunk, OnMatch&& onMatch) {
+        size_t m = pattern.length();
+        if (m == 0) {
+            offset += chunk.size();
+            return;
+        }
+        for (size_t k = 0; k < chunk.size(); k++) {
+            char c = chunk[k];
+            while (j > 0 && pattern[j] != c) j = lps[j - 1];
+            if (pattern[j] == c) j++;
+            if (j == m) {
+                matchCount++;
+                onMatch(offset + k + 1 - m);
+                j = lps[j - 1];
+            }
+        }
+        offset += chunk.size();
     }
 
-    string pattern = "ATGTGTGGCATTTGGGCGCTGTTTGGCAGTGATGATTGCCTTTCTGTTCAGTGTCTGAGTGCTATGAAGATTGCACACAGAGGTCCAGATGCATTCCGTTTTGAGAATGTCAATGGATACACCAACTGCTGCTTTGGATTTCACCGGTTGGCGGTAGTTGACCCGCTGTTTGGAATGCAGCCAATTCGAGTGAAGAAATATCCGTATTTGTGGCTCTGTTACAATGGTGAAATCTACAACCATAAGAAGATGCAACAGCATTTTGAATTTGAATACCAGACCAAAGTGGATGGTGAGATAATCCTTCATCTTTATGACAAAGGAGGAATTGAGCAAACAATTTGTATGTTGGATGGTGTGTTTGCATTTGTTTTACTGGATACTGCCAATAAGAAAGTGTTCCTGGGTAGAGATACATATGGAGTCAGACCTTTGTTTAAAGCAATGACAGAAGATGGATTTTTGGCTGTATGTTCAGAAGCTAAAGGTCTTGTTACATTGAAGCACTCCGCGACTCCCTTTTTAAAAGTGGAGCCTTTTCTTCCTGGACACTATGAAGTTTTGGATTTAAAGCCAAATGGCAAAGTTGCATCCGTGGAAATGGTTAAATATCATCACTGTCGGGATGTACCCCTGCACGCCCTCTATGACAATGTGGAGAAACTCTTTCCAGGTTTTGAGATAGAAACTGTGAAGAACAACCTCAGGATCCTTTTTAATAATGCTGTAAAGAAACGTTTGATGACAGACAGAAGGATTGGCTGCCTTTTATCAGGGGGCTTGGACTCCAGCTTGGTTGCTGCCACTCTGTTGAAGCAGCTGAAAGAAGCCCAAGTACAGTATCCTCTCCAGACATTTGCAATTGGCATGGAAGACAGCCCCGATTTACTGGCTGCTAGAAAGGTGGCAGATCATATTGGAAGTGAACATTATGAAGTCCTTTTTAACTCTGAGGAAGGCATTCAGGCTCTGGATGAAGTCATATTTTCCTTGGAAACTTATGACATTACAACAGTTCGTGCTTCAGTAGGTATGTATTTAATTTCCAAGTATATTCGGAAGAACACAGATAGCGTGGTGATCTTCTCTGGAGAAGGATCAGATGAACTTACGCAGGGTTACATATATTTTCACAAGGCTCCTTCTCCTGAAAAAGCCGAGGAGGAGAGTGAGAGGCTTCTGAGGGAACTCTATTTGTTTGATGTTCTCCGCGCAGATCGAACTACTGCTGCCCATGGTCTTGAACTGAGAGTCCCATTTCTAGATCATCGATTTTCTTCCTATTACTTGTCTCTGCCACCAGAAATGAGAATTCCAAAGAATGGGATAGAAAAACATCTCCTGAGAGAGACGTTTGAGGATTCCAATCTGATACCCAAAGAGATTCTCTGGCGACCAAAAGAAGCCTTCAGTGATGGAATAACTTCAGTTAAGAATTCCTGGTTTAAGATTTTACAGGAATACGTTGAACATCAGGTTGATGATGCAATGATGGCAAATGCAGCCCAGAAATTTCCCTTCAATACTCCTAAAACCAAAGAAGGATATTACTACCGTCAAGTCTTTGAACGCCATTACCCAGGCCGGGCTGACTGGCTGAGCCATTACTGGATGCCCAAGTGGATCAATGCCACTGACCCTTCTGCCCGCACGCTGACCCACTACAAGTCAGCTGTCAAAGCTTAG"; 
-    string dna;
-    int dnaClass;
-    int processedCount = 0;
+    void feed(string_view chunk) { feed(chunk, [](uint64_t) {}); }
 
-    cout << fixed << setprecision(4);
-    cout << "\nANALISIS DETAIL MEMORI (Satuan: Byte)" << endl;
-    cout << "========================================================================================================================================" << endl;
-    
-    cout << left << setw(4) << "No" 
-         << setw(7) << "Class" 
-         << setw(8) << "Algo" 
-         << setw(12) << "Comp." 
-         << setw(10) << "Time(ms)" 
-         << setw(8) << "Match" 
-         << "| "
-         << setw(10) << "InputMem" 
-         << setw(10) << "LPS Mem" 
-         << setw(10) << "StackMem" 
-         << setw(12) << "TOTAL MEM" << endl;
-         
-    cout << "----------------------------------------------------------------------------------------------------------------------------------------" << endl;
+    void reset() {
+        j = 0;
+        offset = 0;
+        matchCount = 0;
+    }
 
-    while (file >> dna >> dnaClass && processedCount < limit) {
-        processedCount++;
+    uint64_t position() const { return offset; }   // byte yang sudah diproses
+    uint64_t matches() const { return matchCount; }
+    size_t state() const { return j; }
 
-        AnalysisResult resNaive = naiveSearch(dna, pattern);
-        AnalysisResult resKMP = kmpSearch(dna, pattern);
-
-        cout << left << setw(4) << processedCount 
-             << setw(7) << dnaClass 
-             << setw(8) << resNaive.algorithm 
-             << setw(12) << resNaive.comparisons 
-             << setw(10) << resNaive.duration 
-             << setw(8) << resNaive.matches 
-             << "| "
-             << setw(10) << resNaive.inputMem 
-             << setw(10) << resNaive.lpsMem 
-             << setw(10) << resNaive.stackMem 
-             << setw(12) << resNaive.totalMem << endl;
-
-        cout << left << setw(4) << "" 
-             << setw(7) << dnaClass 
-             << setw(8) << resKMP.algorithm 
-             << setw(12) << resKMP.comparisons 
-             << setw(10) << resKMP.duration 
-             << setw(8) << resKMP.matches 
-             << "| "
-             << setw(10) << resKMP.inputMem 
-             << setw(10) << resKMP.lpsMem 
-             << setw(10) << resKMP.stackMem 
-             << setw(12) << resKMP.totalMem << endl;
-        
-        cout << "----------------------------------------------------------------------------------------------------------------------------------------" << endl;
-    }
-
-    file.close();
-    if (processedCount == 0) cout << "File kosong atau format salah." << endl;
+private:
+    string_view pattern;
+    const vector<int>& lps;
+    size_t j = 0;
+    uint64_t offset = 0;
+    uint64_t matchCount = 0;
+};
+
+// ==========================================
+// ALGORITMA KMP-DFA (TABEL TRANSISI)
+// ==========================================
+// Tabel LPS dikompilasi menjadi DFA (m+1) x 5 (lihat buildKmpDfa): kolom A,C,G,T
+// dan satu kolom "lain" (N/IUPAC) yang selalu kembali ke state 0. Scan = satu
+// lookup per basa, tanpa cabang yang bergantung pada data.
+AnalysisResult kmpDfaSearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    // Pola dengan simbol non-ACGT tidak bisa dibedakan di kolom "lain"
+    if (cp.dfa.empty()) {
+        AnalysisResult fallback = kmpSearch(text, cp, sink);
+        fallback.algorithm = "KMP-DFA";
+        return fallback;
+    }
+
+    long long comparisons = 0;
+    int matches = 0;
+    int n = text.length();
+    int m = cp.text.length();
+
+    auto start = chrono::high_resolution_clock::now();
+
+    const int32_t* table = cp.dfa.data();
+    const unsigned char* t = (const unsigned char*)text.data();
+    int32_t state = 0;
+    if (sink == nullptr) {
+        for (int i = 0; i < n; i++) {
+            state = table[state * DFA_SYMBOLS + dfaCodes.code[t[i]]];
+            matches += (state == m);
+        }
+    } else {
+        // Loop terpisah agar jalur count-only tetap tanpa cabang
+        for (int i = 0; i < n; i++) {
+            state = table[state * DFA_SYMBOLS + dfaCodes.code[t[i]]];
+            if (state == m) {
+                matches++;
+                sink->report((uint64_t)i + 1 - m);
+            }
+        }
+    }
+    comparisons += n;
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    size_t inputMem = getStringMemory(text) + getStringMemory(cp.text);
+    size_t lpsMem = cp.lpsMemory() + cp.dfaMemory();
+    size_t stackMem = (5 * sizeof(int)) + sizeof(long long);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"KMP-DFA", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
 }
 
-int main() {
-    int limit;
-    cout << "--- DNA Matching Memory Analysis ---" << endl;
-    cout << "Masukkan jumlah sekuens yang ingin dicek: ";
-    cin >> limit;
+// ==========================================
+// ALGORITMA TWO-WAY (CROCHEMORE-PERRIN)
+// ==========================================
+// Bagian kanan faktorisasi dicocokkan kiri->kanan, lalu bagian kiri kanan->kiri.
+// Waktu linear (<= 2n perbandingan) seperti KMP, tetapi tanpa tabel: memori
+// tambahan hanya TwoWayPlan. Untuk pola periodik, 'memory' mengingat prefix
+// yang sudah pasti cocok setelah geser sejauh periode.
+AnalysisResult twoWaySearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    string_view pattern = cp.text;
+    const TwoWayPlan& plan = cp.twoWay;
+    long long comparisons = 0;
+    int matches = 0;
+    long long n = text.length();
+    long long m = pattern.length();
+    long long ell = plan.critical;
+    long long per = plan.period;
+    const char* x = pattern.data();
+    const char* y = text.data();
+
+    auto start = chrono::high_resolution_clock::now();
+
+    long long j = 0;
+    long long memory = -1;
+    while (m > 0 && j <= n - m) {
+        long long i = (plan.periodic ? max(ell, memory) : ell) + 1;
+        while (i < m && (comparisons++, x[i] == y[i + j])) i++;
+        if (i < m) {
+            j += i - ell;
+            memory = -1;
+            continue;
+        }
+        long long leftEnd = plan.periodic ? memory : -1;
+        i = ell;
+        while (i > leftEnd && (comparisons++, x[i] == y[i + j])) i--;
+        if (i <= leftEnd) {
+            matches++;
+            if (sink) sink->report(j);
+        }
+        j += per;
+        if (plan.periodic) memory = m - per - 1;
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
+    size_t lpsMem = sizeof(TwoWayPlan);
+    size_t stackMem = (8 * sizeof(long long)) + sizeof(int);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"TwoWay", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// Naive di atas PackedSeq: satu perbandingan = 32 basa (satu word 64-bit)
+AnalysisResult naiveSearchPacked(const PackedSeq& text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    const PackedSeq& pattern = cp.packed;
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length;
+    size_t m = pattern.length;
+    bool checkExceptions = !text.nmask.empty() || !pattern.nmask.empty();
+
+    size_t inputMem = getPackedMemory(text) + getPackedMemory(pattern);
+    size_t lpsMem = 0;
+    size_t stackMem = (5 * sizeof(size_t)) + sizeof(long long);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    auto start = chrono::high_resolution_clock::now();
+
+    size_t words = (m + 31) / 32;
+    uint64_t lastMask = (m % 32 == 0) ? ~0ULL : ((1ULL << (2 * (m % 32))) - 1);
+
+    for (size_t i = 0; m > 0 && i + m <= n; i++) {
+        size_t w;
+        for (w = 0; w < words; w++) {
+            comparisons++;
+            uint64_t diff = loadBits(text.bits, 2 * (i + 32 * w)) ^ pattern.bits[w];
+            if (w == words - 1) diff &= lastMask;
+            if (diff) break;
+        }
+        if (w == words && (!checkExceptions || exceptionsMatch(text, i, pattern))) {
+            matches++;
+            if (sink) sink->report(i);
+        }
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    return {"Naive2b", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// KMP di atas PackedSeq: alur sama dengan kmpSearch, teks dibaca word demi word lewat PackedCursor
+AnalysisResult kmpSearchPacked(const PackedSeq& text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    const PackedSeq& pattern = cp.packed;
+    const vector<int>& lps = cp.lps;
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length;
+    size_t m = pattern.length;
+
+    auto start = chrono::high_resolution_clock::now();
+
+    // Alur sama persis dengan kmpSearch; hanya text[i] diganti cursor.symbol().
+    // Saat j = 0 gagal, basa yang pasti gagal lagi dilompati per word, dan
+    // tiap basa yang dilompati tetap dihitung satu perbandingan.
+    string_view patternText = cp.text;
+    int firstCode = m > 0 ? baseCode(patternText[0]) : -1;
+    PackedCursor cursor(text);
+    size_t i = 0;
+    size_t j = 0;
+    while (m > 0 && i < n) {
+        comparisons++;
+        if (patternText[j] == cursor.symbol()) {
+            i++;
+            j++;
+            cursor.advance();
+        }
+        if (j == m) {
+            matches++;
+            if (sink) sink->report(i - m);
+            j = lps[j - 1];
+        } else if (i < n && patternText[j] != cursor.symbol()) {
+            if (j != 0) {
+                j = lps[j - 1];
+            } else {
+                i++;
+                cursor.advance();
+                if (firstCode >= 0 && i < n) {
+                    size_t skipped = cursor.skipUntil(firstCode, n - i);
+                    i += skipped;
+                    comparisons += skipped;
+                }
+            }
+        }
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    size_t inputMem = getPackedMemory(text) + getPackedMemory(pattern);
+    size_t lpsMem = cp.lpsMemory();
+    size_t stackMem = (5 * sizeof(size_t)) + sizeof(long long);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"KMP2b", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// ==========================================
+// ALGORITMA SIMD (FILTER BYTE PERTAMA & TERAKHIR)
+// ==========================================
+// Untuk setiap blok posisi, byte pertama dan terakhir pola dibandingkan
+// sekaligus; hanya kandidat yang lolos kedua filter diverifikasi dengan memcmp.
+// Jalur (AVX2 / SSE2 / scalar) dipilih sekali saat runtime.
+enum class SimdPath { Scalar, SSE2, AVX2 };
+
+SimdPath detectSimdPath() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdPath::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdPath::SSE2;
+#endif
+    return SimdPath::Scalar;
+}
+
+const char* simdPathName(SimdPath path) {
+    switch (path) {
+        case SimdPath::AVX2: return "AVX2";
+        case SimdPath::SSE2: return "SSE2";
+        default:             return "Scalar";
+    }
+}
+
+const SimdPath activeSimdPath = detectSimdPath();
+
+// Sisa posisi [i, n-m] (atau seluruh teks pada jalur scalar)
+int simdScanScalar(const char* t, size_t n, const char* p, size_t m, size_t i, long long& comparisons, MatchSink* sink) {
+    int matches = 0;
+    size_t inner = (m > 2) ? m - 2 : 0;
+    for (; i + m <= n; i++) {
+        comparisons++;
+        if (t[i] == p[0] && t[i + m - 1] == p[m - 1]) {
+            comparisons++;
+            if (memcmp(t + i + 1, p + 1, inner) == 0) {
+                matches++;
+                if (sink) sink->report(i);
+            }
+        }
+    }
+    return matches;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+int simdScanSSE2(const char* t, size_t n, const char* p, size_t m, long long& comparisons, MatchSink* sink) {
+    int matches = 0;
+    size_t inner = (m > 2) ? m - 2 : 0;
+    const __m128i first = _mm_set1_epi8(p[0]);
+    const __m128i last = _mm_set1_epi8(p[m - 1]);
+    size_t i = 0;
+    for (; i + m + 15 <= n; i += 16) {
+        comparisons++;
+        __m128i blockFirst = _mm_loadu_si128((const __m128i*)(t + i));
+        __m128i blockLast = _mm_loadu_si128((const __m128i*)(t + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                                        _mm_cmpeq_epi8(blockLast, last)));
+        while (mask) {
+            unsigned bit = __builtin_ctz(mask);
+            comparisons++;
+            if (memcmp(t + i + bit + 1, p + 1, inner) == 0) {
+                matches++;
+                if (sink) sink->report(i + bit);
+            }
+            mask &= mask - 1;
+        }
+    }
+    return matches + simdScanScalar(t, n, p, m, i, comparisons, sink);
+}
+
+__attribute__((target("avx2")))
+int simdScanAVX2(const char* t, size_t n, const char* p, size_t m, long long& comparisons, MatchSink* sink) {
+    int matches = 0;
+    size_t inner = (m > 2) ? m - 2 : 0;
+    const __m256i first = _mm256_set1_epi8(p[0]);
+    const __m256i last = _mm256_set1_epi8(p[m - 1]);
+    size_t i = 0;
+    for (; i + m + 31 <= n; i += 32) {
+        comparisons++;
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(t + i));
+        __m256i blockLast = _mm256_loadu_si256((const __m256i*)(t + i + m - 1));
+        unsigned mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first),
+                                                              _mm256_cmpeq_epi8(blockLast, last)));
+        while (mask) {
+            unsigned bit = __builtin_ctz(mask);
+            comparisons++;
+            if (memcmp(t + i + bit + 1, p + 1, inner) == 0) {
+                matches++;
+                if (sink) sink->report(i + bit);
+            }
+            mask &= mask - 1;
+        }
+    }
+    return matches + simdScanScalar(t, n, p, m, i, comparisons, sink);
+}
+#endif
+
+AnalysisResult simdSearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    string_view pattern = cp.text;
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length();
+    size_t m = pattern.length();
+
+    size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
+    size_t lpsMem = 0;
+    // Variabel lokal + dua register broadcast (byte pertama & terakhir)
+    size_t stackMem = (5 * sizeof(size_t)) + sizeof(long long) + 2 * 32;
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    auto start = chrono::high_resolution_clock::now();
+
+    if (m > 0 && m <= n) {
+        switch (activeSimdPath) {
+#if defined(__x86_64__) || defined(__i386__)
+            case SimdPath::AVX2: matches = simdScanAVX2(text.data(), n, pattern.data(), m, comparisons, sink); break;
+            case SimdPath::SSE2: matches = simdScanSSE2(text.data(), n, pattern.data(), m, comparisons, sink); break;
+#endif
+            default: matches = simdScanScalar(text.data(), n, pattern.data(), m, 0, comparisons, sink); break;
+        }
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    return {"SIMD", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// ==========================================
+// ALGORITMA BIT-PARALLEL (SHIFT-AND & BNDM)
+// ==========================================
+// Shift-And memakai bit vector multi-word sehingga panjang pola tidak dibatasi
+// 64; BNDM memakai faktor 64 basa + verifikasi. Mask per simbol diambil dari
+// CompiledPattern.
+
+
+AnalysisResult shiftAndSearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    string_view pattern = cp.text;
+    const BitMasks& bm = cp.forwardMasks;
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length();
+    size_t m = pattern.length();
+
+    auto start = chrono::high_resolution_clock::now();
+
+    // Buffer D dipakai ulang antar panggilan (per thread), tanpa alokasi per record
+    static thread_local vector<uint64_t> D;
+    size_t W = bm.words;
+    D.assign(W, 0);
+    uint64_t highBit = (m > 0) ? 1ULL << ((m - 1) % 64) : 0;
+
+    // Hanya word [0, active) yang mungkin tidak nol, jadi word di atasnya dilewati
+    size_t active = 1;
+    for (size_t i = 0; m > 0 && i < n; i++) {
+        const uint64_t* b = bm.maskFor(text[i]);
+        size_t limit = min(W, active + 1);
+        uint64_t carry = 1;
+        for (size_t w = 0; w < limit; w++) {
+            uint64_t shifted = (D[w] << 1) | carry;
+            carry = D[w] >> 63;
+            D[w] = shifted & b[w];
+        }
+        active = limit;
+        while (active > 1 && D[active - 1] == 0) active--;
+        comparisons += limit;
+        if (D[W - 1] & highBit) {
+            matches++;
+            if (sink) sink->report(i + 1 - m);
+        }
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
+    size_t lpsMem = bm.memory() + sizeof(vector<uint64_t>) + W * sizeof(uint64_t);
+    size_t stackMem = (6 * sizeof(size_t)) + sizeof(long long) + 2 * sizeof(uint64_t);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"ShiftAnd", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// Pola > 64 basa: BNDM satu word atas faktor prefix 64 basa (cp.reverseMasks
+// hanya memuat prefix itu), lalu sisa pola diverifikasi dengan memcmp. Total
+// byte verifikasi dibatasi BNDM_VERIFY_BUDGET x n; jika habis (pola periodik
+// pada teks repeat), sisa teks diselesaikan dengan KMP sehingga worst case
+// tetap linear, bukan O(n * m).
+const size_t BNDM_VERIFY_BUDGET = 4;
+
+AnalysisResult bndmSearch(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    string_view pattern = cp.text;
+    const BitMasks& bm = cp.reverseMasks;
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length();
+    size_t m = pattern.length();
+    size_t f = min(m, BNDM_FACTOR);
+
+    auto start = chrono::high_resolution_clock::now();
+
+    uint64_t highBit = (f > 0) ? 1ULL << (f - 1) : 0;
+    uint64_t topMask = (f == 64) ? ~0ULL : ((1ULL << f) - 1);
+    size_t verifyBudget = BNDM_VERIFY_BUDGET * n;
+    size_t verified = 0;
+
+    size_t pos = 0;
+    while (m > 0 && pos + m <= n) {
+        if (verified > verifyBudget) break;
+        // Jendela baru: semua faktor masih mungkin (f bit = 1)
+        uint64_t D = topMask;
+        size_t j = f;
+        size_t last = f;
+        while (j > 0 && D != 0) {
+            D &= bm.maskFor(text[pos + j - 1])[0];
+            comparisons++;
+            j--;
+            if (D & highBit) {
+                if (j > 0) last = j;
+                else {
+                    bool found = true;
+                    if (m > f) {
+                        comparisons++;
+                        verified += m - f;
+                        found = memcmp(text.data() + pos + f, pattern.data() + f, m - f) == 0;
+                    }
+                    if (found) {
+                        matches++;
+                        if (sink) sink->report(pos);
+                    }
+                }
+            }
+            D = (D << 1) & topMask;
+        }
+        pos += last;
+    }
+
+    // Sisa teks (hanya jika anggaran verifikasi habis) dengan KMP biasa
+    if (m > 0 && pos + m <= n) {
+        const vector<int>& lps = cp.lps;
+        size_t j = 0;
+        for (size_t i = pos; i < n; i++) {
+            while (j > 0 && pattern[j] != text[i]) {
+                comparisons++;
+                j = lps[j - 1];
+            }
+            comparisons++;
+            if (pattern[j] == text[i]) j++;
+            if (j == m) {
+                matches++;
+                if (sink) sink->report(i + 1 - m);
+                j = lps[j - 1];
+            }
+        }
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
+    size_t lpsMem = bm.memory() + (m > f ? cp.lpsMemory() : 0);
+    size_t stackMem = (8 * sizeof(size_t)) + sizeof(long long) + 3 * sizeof(uint64_t);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"BNDM", comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// ==========================================
+// PENCARIAN APROKSIMASI (MYERS BIT-VECTOR)
+// ==========================================
+// Edit distance semi-global: pola boleh mulai di posisi mana pun pada teks.
+// Pola dipecah menjadi blok 64 baris; hanya blok sampai "y" (blok aktif
+// terakhir, cut-off Ukkonen) yang dihitung per kolom.
+struct ApproxHit {
+    size_t end;     // posisi akhir match di teks (inklusif)
+    int distance;   // edit distance (substitusi/insersi/delesi)
+};
+
+struct MyersBlock {
+    uint64_t P;
+    uint64_t M;
+    uint64_t highBit;   // bit baris terakhir blok
+    int score;          // nilai sel pada baris terakhir blok
+    int len;            // jumlah baris pola di blok ini (64, kecuali blok terakhir)
+};
+
+// Satu kolom untuk satu blok; hin/hout adalah delta horizontal di batas blok
+inline int myersAdvanceBlock(MyersBlock& blk, uint64_t eq, int hin) {
+    uint64_t Pv = blk.P;
+    uint64_t Mv = blk.M;
+    uint64_t Xv = eq | Mv;
+    if (hin < 0) eq |= 1;
+    uint64_t Xh = (((eq & Pv) + Pv) ^ Pv) | eq;
+    uint64_t Ph = Mv | ~(Xh | Pv);
+    uint64_t Mh = Pv & Xh;
+
+    int hout = 0;
+    if (Ph & blk.highBit) hout = 1;
+    else if (Mh & blk.highBit) hout = -1;
+
+    Ph <<= 1;
+    Mh <<= 1;
+    if (hin < 0) Mh |= 1;
+    else if (hin > 0) Ph |= 1;
+
+    blk.P = Mh | ~(Xv | Ph);
+    blk.M = Ph & Xv;
+    return hout;
+}
+
+// Sink menerima posisi AKHIR (inklusif), karena awal match aproksimasi tidak tunggal.
+// hits: buffer milik pemanggil, hanya hitCapacity hit pertama yang disimpan
+// (tanpa alokasi); matches tetap menghitung semuanya.
+AnalysisResult myersSearch(string_view text, const CompiledPattern& cp, int maxEdits, ApproxHit* hits,
+                           size_t hitCapacity, MatchSink* sink = nullptr) {
+    string_view pattern = cp.text;
+    const BitMasks& peq = cp.forwardMasks;
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length();
+    size_t m = pattern.length();
+    int k = maxEdits;
+
+    auto start = chrono::high_resolution_clock::now();
+
+    static thread_local vector<MyersBlock> blk;
+    int blocks = (int)peq.words;
+    blk.resize(blocks);
+    for (int b = 0; b < blocks; b++) {
+        blk[b].len = (b == blocks - 1) ? (int)(m - 64 * (size_t)b) : 64;
+        blk[b].highBit = 1ULL << (blk[b].len - 1);
+    }
+
+    int y = 0;
+    if (m > 0) {
+        y = min(blocks - 1, max(0, (k + 63) / 64 - 1));
+        for (int b = 0; b <= y; b++) {
+            blk[b].P = ~0ULL;
+            blk[b].M = 0;
+            blk[b].score = (b == 0 ? 0 : blk[b - 1].score) + blk[b].len;
+        }
+    }
+
+    for (size_t j = 0; m > 0 && j < n; j++) {
+        const uint64_t* eq = peq.maskFor(text[j]);
+        int carry = 0;
+        for (int b = 0; b <= y; b++) {
+            carry = myersAdvanceBlock(blk[b], eq[b], carry);
+            blk[b].score += carry;
+        }
+        comparisons += y + 1;
+
+        if (blk[y].score - carry <= k && y < blocks - 1 && ((eq[y + 1] & 1) || carry < 0)) {
+            // Aktifkan blok berikutnya: kolom sebelumnya dianggap naik +1 per baris
+            y++;
+            blk[y].P = ~0ULL;
+            blk[y].M = 0;
+            int hout = myersAdvanceBlock(blk[y], eq[y], carry);
+            blk[y].score = blk[y - 1].score - carry + blk[y].len + hout;
+            comparisons++;
+        } else {
+            while (y > 0 && blk[y].score >= k + blk[y].len) y--;
+        }
+
+        if (y == blocks - 1 && blk[y].score <= k) {
+            if (hits != nullptr && (size_t)matches < hitCapacity) hits[matches] = {j, blk[y].score};
+            matches++;
+            if (sink) sink->report(j);
+        }
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
+    size_t lpsMem = peq.memory() + sizeof(vector<MyersBlock>) + blocks * sizeof(MyersBlock);
+    size_t stackMem = (6 * sizeof(size_t)) + sizeof(long long) + 3 * sizeof(int);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"Myers-k" + to_string(k), comparisons, elapsed.count(), matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+// ==========================================
+// DISPATCHER OTOMATIS
+// ==========================================
+// Memilih satu engine per pola dari PatternProfile:
+//   - pola (hampir) periodik            -> periodicEngine (default KMP-DFA, linear di teks berulang;
+//     hanya KMP/KMP-DFA/TwoWay yang diterima, SIMD/BNDM bisa O(n*m) di teks berulang)
+//     periodik = 2 * periode <= m, atau prefix/suffix periodik menutup >= separuh pola
+//   - satu simbol dominan (skew >= skewLimit) -> skewedEngine (default SIMD)
+//   - selain itu SIMD untuk pola pendek, BNDM mulai bndmMinLength
+// Titik-titik ini bisa dikalibrasi sekali di mesin ini (--calibrate) dan disimpan ke file.
+enum class EngineKind { Naive, Kmp, KmpDfa, TwoWay, Simd, Bndm };
+
+const char* engineName(EngineKind kind) {
+    switch (kind) {
+        case EngineKind::Naive:  return "Naive";
+        case EngineKind::Kmp:    return "KMP";
+        case EngineKind::KmpDfa: return "KMP-DFA";
+        case EngineKind::TwoWay: return "TwoWay";
+        case EngineKind::Simd:   return "SIMD";
+        default:                 return "BNDM";
+    }
+}
+
+bool parseEngineName(const string& name, EngineKind& kind) {
+    for (EngineKind k : {EngineKind::Naive, EngineKind::Kmp, EngineKind::KmpDfa, EngineKind::TwoWay, EngineKind::Simd,
+                         EngineKind::Bndm}) {
+        if (name == engineName(k)) {
+            kind = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Engine dengan worst case O(n + m), satu-satunya pilihan sah untuk pola periodik
+bool linearEngine(EngineKind kind) {
+    return kind == EngineKind::Kmp || kind == EngineKind::KmpDfa || kind == EngineKind::TwoWay;
+}
+
+struct DispatchConfig {
+    size_t bndmMinLength = 256;
+    double skewLimit = 0.5;
+    EngineKind periodicEngine = EngineKind::KmpDfa;
+    EngineKind skewedEngine = EngineKind::Simd;
+    bool calibrated = false;    // true jika dibaca dari file kalibrasi
+
+    // Format: satu "kunci nilai" per baris, '#' = komentar
+    bool load(const string& path) {
+        ifstream file(path);
+        if (!file) return false;
+        string line;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            stringstream row(line);
+            string key, value;
+            row >> key >> value;
+            if (key == "bndm_min_length") bndmMinLength = (size_t)strtoull(value.c_str(), nullptr, 10);
+            else if (key == "skew_limit") skewLimit = atof(value.c_str());
+            else if (key == "periodic_engine") {
+                EngineKind kind;
+                if (parseEngineName(value, kind) && linearEngine(kind)) periodicEngine = kind;
+            }
+            else if (key == "skewed_engine") parseEngineName(value, skewedEngine);
+        }
+        calibrated = true;
+        return true;
+    }
+
+    bool save(const string& path) const {
+        ofstream file(path);
+        if (!file) return false;
+        file << "# Kalibrasi dispatcher (--calibrate)\n"
+             << "bndm_min_length " << bndmMinLength << "\n"
+             << "skew_limit " << skewLimit << "\n"
+             << "periodic_engine " << engineName(periodicEngine) << "\n"
+             << "skewed_engine " << engineName(skewedEngine) << "\n";
+        return (bool)file;
+    }
+};
+
+AnalysisResult runEngine(EngineKind kind, string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) {
+    switch (kind) {
+        case EngineKind::Naive:  return naiveSearchFast(text, cp, sink);
+        case EngineKind::Kmp:    return kmpSearchFast(text, cp, sink);
+        case EngineKind::KmpDfa: return kmpDfaSearch(text, cp, sink);
+        case EngineKind::TwoWay: return twoWaySearch(text, cp, sink);
+        case EngineKind::Simd:   return simdSearch(text, cp, sink);
+        default:                 return bndmSearch(text, cp, sink);
+    }
+}
+
+class EngineDispatcher {
+public:
+    explicit EngineDispatcher(const DispatchConfig& config = DispatchConfig()) : config(config) {}
+
+    EngineKind choose(const CompiledPattern& cp) const {
+        const PatternProfile& profile = cp.profile;
+        if (profile.length == 0) return EngineKind::Naive;
+        EngineKind kind;
+        if (profile.periodic()) kind = config.periodicEngine;
+        else if (profile.skew >= config.skewLimit) kind = config.skewedEngine;
+        else kind = (profile.length >= config.bndmMinLength) ? EngineKind::Bndm : EngineKind::Simd;
+        if (kind == EngineKind::KmpDfa && cp.dfa.empty()) kind = EngineKind::Kmp;
+        return kind;
+    }
+
+    // Naive/KMP memakai varian NoStats (jalur produksi); algorithm = "A:" + engine terpilih
+    AnalysisResult search(string_view text, const CompiledPattern& cp, MatchSink* sink = nullptr) const {
+        EngineKind kind = choose(cp);
+        AnalysisResult r = runEngine(kind, text, cp, sink);
+        r.algorithm = string("A:") + engineName(kind);
+        return r;
+    }
+
+    const DispatchConfig& settings() const { return config; }
+
+private:
+    DispatchConfig config;
+};
+
+// ==========================================
+// ALGORITMA AHO-CORASICK (MULTI-PATTERN)
+// ==========================================
+// Trie semua pola dengan tabel transisi padat 4 simbol (ACGT). Failure link
+// dibangun dengan BFS, idenya sama dengan computeLPS tetapi untuk banyak pola;
+// setelah itu tabel goto dilengkapi sehingga scan = satu lookup per basa.
+class AhoCorasick {
+public:
+    explicit AhoCorasick(const vector<string>& patterns) : patternCount(patterns.size()) {
+        addState();
+        nextPattern.assign(patterns.size(), -1);
+        for (size_t id = 0; id < patterns.size(); id++) {
+            int32_t state = 0;
+            for (char c : patterns[id]) {
+                int code = baseCode(c);
+                if (next[state][code] < 0) {
+                    int32_t created = addState();
+                    next[state][code] = created;
+                }
+                state = next[state][code];
+            }
+            nextPattern[id] = firstPattern[state];
+            firstPattern[state] = (int32_t)id;
+        }
+        buildFailureLinks();
+    }
+
+    // counts[id] += jumlah kemunculan pola id di text (overlap dihitung)
+    void scan(string_view text, vector<long long>& counts, long long& comparisons) const {
+        scanEach(text, [&counts](int32_t id, size_t) { counts[id]++; }, comparisons);
+    }
+
+    // onHit(id, akhir) untuk setiap kemunculan; akhir = indeks basa terakhir kemunculan
+    template <typename OnHit>
+    void scanEach(string_view text, OnHit&& onHit, long long& comparisons) const {
+        int32_t state = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            int code = baseCode(text[i]);
+            comparisons++;
+            if (code < 0) {
+                state = 0;  // pola hanya ACGT, basa lain memutus semua kandidat
+                continue;
+            }
+            state = next[state][code];
+            for (int32_t out = outState[state]; out >= 0; out = dictLink[out]) {
+                for (int32_t id = firstPattern[out]; id >= 0; id = nextPattern[id]) onHit(id, i);
+            }
+        }
+    }
+
+    size_t stateCount() const { return next.size(); }
+    size_t size() const { return patternCount; }
+
+    size_t tableMemory() const {
+        return next.capacity() * sizeof(array<int32_t, 4>)
+             + (fail.capacity() + dictLink.capacity() + outState.capacity()
+                + firstPattern.capacity() + nextPattern.capacity()) * sizeof(int32_t);
+    }
+
+private:
+    int32_t addState() {
+        next.push_back({-1, -1, -1, -1});
+        firstPattern.push_back(-1);
+        return (int32_t)next.size() - 1;
+    }
+
+    void buildFailureLinks() {
+        size_t states = next.size();
+        fail.assign(states, 0);
+        dictLink.assign(states, -1);
+        outState.assign(states, -1);
+
+        vector<int32_t> order;
+        order.reserve(states);
+        for (int c = 0; c < 4; c++) {
+            if (next[0][c] < 0) next[0][c] = 0;
+            else order.push_back(next[0][c]);
+        }
+        for (size_t head = 0; head < order.size(); head++) {
+            int32_t s = order[head];
+            for (int c = 0; c < 4; c++) {
+                int32_t child = next[s][c];
+                if (child < 0) {
+                    next[s][c] = next[fail[s]][c];
+                    continue;
+                }
+                int32_t f = next[fail[s]][c];
+                fail[child] = f;
+                dictLink[child] = (firstPattern[f] >= 0) ? f : dictLink[f];
+                order.push_back(child);
+            }
+        }
+        for (size_t s = 0; s < states; s++) {
+            outState[s] = (firstPattern[s] >= 0) ? (int32_t)s : dictLink[s];
+        }
+    }
+
+    size_t patternCount;
+    vector<array<int32_t, 4>> next;
+    vector<int32_t> fail;
+    vector<int32_t> dictLink;       // state terminal terdekat lewat rantai failure
+    vector<int32_t> outState;       // state itu sendiri jika terminal, selain itu dictLink
+    vector<int32_t> firstPattern;   // daftar berantai id pola yang berakhir di state
+    vector<int32_t> nextPattern;
+};
+
+// Satu pola per baris; baris kosong, komentar '#' dan header '>' dilewati.
+// Pola dengan basa selain ACGT tidak bisa masuk tabel 4 simbol, jadi ditolak.
+bool loadPatterns(const string& path, vector<string>& patterns) {
+    ifstream file(path);
+    if (!file.is_open()) return false;
+    string line;
+    int lineNo = 0;
+    while (getline(file, line)) {
+        lineNo++;
+        string probe;
+        for (char c : line) {
+            if (!isspace((unsigned char)c)) probe += (char)toupper((unsigned char)c);
+        }
+        if (probe.empty() || probe[0] == '#' || probe[0] == '>') continue;
+        bool valid = true;
+        for (char c : probe) valid = valid && baseCode(c) >= 0;
+        if (!valid) {
+            cout << "Peringatan: pola baris " << lineNo << " berisi basa non-ACGT, dilewati." << endl;
+            continue;
+        }
+        patterns.push_back(probe);
+    }
+    return true;
+}
+
+// ==========================================
+// RABIN-KARP BATCH (PROBE SAMA PANJANG)
+// ==========================================
+// Semua probe panjang k disimpan di satu hash set open addressing (linear
+// probing, load <= 0.5). Hash jendela k basa di-roll sekali per basa teks,
+// lalu satu lookup: biaya per basa hampir tetap berapa pun jumlah probenya.
+// Untuk k <= 32 jendela 2-bit itu sendiri adalah kuncinya (perfect hash,
+// tanpa verifikasi); untuk k > 32 dipakai hash polinomial mod 2^64 dan
+// kandidat diverifikasi byte per byte.
+// Di depan tabel ada filter 1 bit per slot filter (~16 bit per probe): hampir
+// semua jendela teks bukan probe dan ditolak filter dengan cabang yang mudah
+// ditebak, jadi lookup tabel (dan cache miss-nya) hanya untuk sedikit kandidat.
+class RabinKarpSet {
+public:
+    // Semua probe harus sama panjang dan ACGT, cek dengan supports()
+    explicit RabinKarpSet(const vector<string>& probes)
+        : probes(probes), k(probes.empty() ? 0 : probes[0].size()) {
+        windowMask = (k >= 32) ? ~0ULL : (1ULL << (2 * k)) - 1;
+        // BASE^k untuk membuang basa yang keluar dari jendela (mode k > 32)
+        outFactor = 1;
+        for (size_t i = 0; i < k; i++) outFactor *= HASH_BASE;
+
+        size_t capacity = 16;
+        while (capacity < probes.size() * 2) capacity <<= 1;
+        slotBits = 0;
+        while ((1ULL << slotBits) < capacity) slotBits++;
+        keys.assign(capacity, 0);
+        heads.assign(capacity, -1);
+        nextProbe.assign(probes.size(), -1);
+        filterBits = 10;
+        while ((1ULL << filterBits) < probes.size() * 16) filterBits++;
+        filter.assign((1ULL << filterBits) / 64, 0);
+
+        for (size_t id = 0; id < probes.size(); id++) {
+            uint64_t key = 0;
+            for (char c : probes[id]) key = roll(key, baseCode(c), 0, false);
+            uint64_t bit = filterIndex(key);
+            filter[bit >> 6] |= 1ULL << (bit & 63);
+            size_t slot = findSlot(key);
+            if (heads[slot] < 0) {
+                keys[slot] = key;
+                distinctKeys++;
+            }
+            nextProbe[id] = heads[slot];
+            heads[slot] = (int32_t)id;
+        }
+        // Kunci 2-bit sudah eksak, teks probe tidak perlu disimpan
+        if (isExact()) vector<string>().swap(this->probes);
+    }
+
+    static bool supports(const vector<string>& probes) {
+        if (probes.empty() || probes[0].empty()) return false;
+        for (const string& p : probes) {
+            if (p.size() != probes[0].size()) return false;
+        }
+        return true;
+    }
+
+    // Antarmuka sama dengan AhoCorasick::scan
+    void scan(string_view text, vector<long long>& counts, long long& comparisons) const {
+        scanEach(text, [&counts](int32_t id, size_t) { counts[id]++; }, comparisons);
+    }
+
+    // onHit(id, akhir) untuk setiap kemunculan; akhir = indeks basa terakhir kemunculan
+    template <typename OnHit>
+    void scanEach(string_view text, OnHit&& onHit, long long& comparisons) const {
+        // Member disalin ke lokal: onHit boleh menulis memori apa pun, jadi
+        // tanpa ini compiler membaca ulang member di setiap basa
+        const bool exact = isExact();
+        const size_t k = this->k;
+        const uint64_t* filterWords = filter.data();
+        const int filterShift = 64 - filterBits;
+        long long verified = 0;
+        uint64_t key = 0;
+        size_t valid = 0;   // panjang run ACGT yang sedang berjalan
+        for (size_t i = 0; i < text.size(); i++) {
+            int code = dfaCodes.code[(unsigned char)text[i]];
+            if (code > 3) {
+                key = 0;    // probe hanya ACGT, jendela dimulai ulang setelah basa lain
+                valid = 0;
+                continue;
+            }
+            bool full = ++valid >= k;
+            key = roll(key, code, (!exact && valid > k) ? dfaCodes.code[(unsigned char)text[i - k]] : 0, valid > k);
+            if (!full) continue;
+
+            uint64_t bit = (key * FILTER_MULTIPLIER) >> filterShift;
+            if (!((filterWords[bit >> 6] >> (bit & 63)) & 1)) continue;
+
+            int32_t id = heads[findSlot(key)];
+            for (; id >= 0; id = nextProbe[id]) {
+                if (!exact) {
+                    verified += (long long)k;
+                    if (text.compare(i + 1 - k, k, probes[id]) != 0) continue;
+                }
+                onHit(id, i);
+            }
+        }
+        comparisons += (long long)text.size() + verified;
+    }
+
+    size_t size() const { return nextProbe.size(); }
+    size_t length() const { return k; }
+    size_t slotCount() const { return keys.size(); }
+    size_t keyCount() const { return distinctKeys; }
+    bool isExact() const { return k <= 32; }
+
+    // Tabel hash + teks probe (hanya disimpan untuk verifikasi mode k > 32)
+    size_t tableMemory() const {
+        size_t probeBytes = probes.capacity() * sizeof(string);
+        for (const string& p : probes) probeBytes += p.capacity();
+        return (keys.capacity() + filter.capacity()) * sizeof(uint64_t)
+             + (heads.capacity() + nextProbe.capacity()) * sizeof(int32_t)
+             + probeBytes;
+    }
+
+private:
+    static constexpr uint64_t HASH_BASE = 0x100000001B3ULL;   // prima FNV-64, ganjil
+
+    // k <= 32: geser 2 bit dan potong ke 2k bit. k > 32: h*B + masuk - keluar*B^k
+    uint64_t roll(uint64_t key, int in, int out, bool full) const {
+        if (isExact()) return ((key << 2) | (uint64_t)in) & windowMask;
+        key = key * HASH_BASE + (uint64_t)in;
+        if (full) key -= (uint64_t)out * outFactor;
+        return key;
+    }
+
+    static constexpr uint64_t FILTER_MULTIPLIER = 0xC2B2AE3D27D4EB4FULL;
+
+    uint64_t filterIndex(uint64_t key) const { return (key * FILTER_MULTIPLIER) >> (64 - filterBits); }
+
+    // Slot kunci itu, atau slot kosong tempat kunci itu seharusnya berada
+    size_t findSlot(uint64_t key) const {
+        size_t mask = keys.size() - 1;
+        size_t slot = (size_t)((key * 0x9E3779B97F4A7C15ULL) >> (64 - slotBits));
+        while (heads[slot] >= 0 && keys[slot] != key) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    vector<string> probes;
+    size_t k;
+    uint64_t windowMask;
+    uint64_t outFactor;
+    int slotBits;
+    size_t distinctKeys = 0;
+    vector<uint64_t> keys;
+    vector<int32_t> heads;       // id probe pertama di slot, -1 = kosong
+    vector<int32_t> nextProbe;   // probe lain dengan kunci sama (duplikat / tabrakan hash)
+    int filterBits;
+    vector<uint64_t> filter;
+};
+
+// ==========================================
+// PENCARIAN DUA UNTAI (REVERSE COMPLEMENT)
+// ==========================================
+// Pola dan reverse complement-nya dimasukkan ke satu automaton Aho-Corasick,
+// jadi kedua untai dicari dalam satu kali baca teks (bukan dua scan terpisah).
+// Posisi hit untai minus dilaporkan dalam koordinat untai plus (awal wilayah
+// di teks). Pola palindrom (pola == reverse complement) cocok di kedua untai
+// sekaligus, sehingga setiap kemunculannya dihitung sekali untuk + dan sekali untuk -.
+
+// A<->T, C<->G; N dan simbol IUPAC lain dibiarkan
+string reverseComplement(string_view s) {
+    string rc(s.rbegin(), s.rend());
+    for (char& c : rc) {
+        switch (c) {
+            case 'A': c = 'T'; break;
+            case 'C': c = 'G'; break;
+            case 'G': c = 'C'; break;
+            case 'T': c = 'A'; break;
+            default:  break;
+        }
+    }
+    return rc;
+}
+
+class StrandScanner {
+public:
+    // Pola harus ACGT (syarat tabel 4 simbol Aho-Corasick), cek dengan supports()
+    explicit StrandScanner(string_view pattern)
+        : patternLength(pattern.size()),
+          palindromic(pattern == reverseComplement(pattern)),
+          automaton({string(pattern), reverseComplement(pattern)}) {}
+
+    static bool supports(string_view pattern) {
+        if (pattern.empty()) return false;
+        for (char c : pattern) {
+            if (baseCode(c) < 0) return false;
+        }
+        return true;
+    }
+
+    size_t length() const { return patternLength; }
+    bool isPalindromic() const { return palindromic; }
+    size_t memory() const { return automaton.tableMemory(); }
+
+    // id 0 = untai plus, id 1 = untai minus
+    template <typename OnHit>
+    void scan(string_view text, OnHit&& onHit, long long& comparisons) const {
+        automaton.scanEach(text, [&](int32_t id, size_t end) { onHit(id, end + 1 - patternLength); }, comparisons);
+    }
+
+private:
+    size_t patternLength;
+    bool palindromic;
+    AhoCorasick automaton;
+};
+
+AnalysisResult bothStrandsSearch(string_view text, const StrandScanner& scanner,
+                                 MatchSink* forwardSink = nullptr, MatchSink* reverseSink = nullptr) {
+    long long comparisons = 0;
+    int strandMatches[2] = {0, 0};
+    MatchSink* sinks[2] = {forwardSink, reverseSink};
+
+    auto start = chrono::high_resolution_clock::now();
+    scanner.scan(text, [&](int32_t strand, size_t pos) {
+        strandMatches[strand]++;
+        if (sinks[strand]) sinks[strand]->report(pos);
+    }, comparisons);
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    // Pola hanya tersimpan di automaton, tetapi dihitung sebagai input seperti engine lain
+    size_t inputMem = getStringMemory(text) + sizeof(string_view) + scanner.length();
+    size_t lpsMem = scanner.memory();
+    size_t stackMem = sizeof(comparisons) + sizeof(strandMatches) + sizeof(sinks);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    AnalysisResult r = {"2Strand", comparisons, elapsed.count(), strandMatches[0] + strandMatches[1], inputMem, lpsMem, stackMem, totalMem};
+    r.forwardMatches = strandMatches[0];
+    r.reverseMatches = strandMatches[1];
+    return r;
+}
+
+// ==========================================
+// PEMBACA KORPUS BERBASIS MMAP (ZERO-COPY)
+// ==========================================
+// human.txt dipetakan langsung ke memori; setiap record hanya berupa
+// (pointer, panjang, kelas) yang menunjuk ke halaman file, tanpa alokasi.
+struct DnaRecord {
+    string_view sequence;
+    int dnaClass;
+    size_t softMasked = 0;  // basa huruf kecil di FASTA/FASTQ (sudah dijadikan huruf besar)
+};
+
+class MappedCorpus {
+public:
+    MappedCorpus() = default;
+    MappedCorpus(const MappedCorpus&) = delete;
+    MappedCorpus& operator=(const MappedCorpus&) = delete;
+
+    ~MappedCorpus() {
+        if (base != nullptr) munmap((void*)base, size);
+        if (fd >= 0) close(fd);
+    }
+
+    bool open(const char* path) {
+        fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) return false;
+        size = st.st_size;
+        if (size == 0) return true;
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            size = 0;
+            return false;
+        }
+        base = (const char*)mapped;
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    // Format sama dengan "file >> dna >> dnaClass"; berhenti pada token rusak.
+    bool next(DnaRecord& rec) {
+        skipSpace();
+        size_t start = pos;
+        while (pos < size && !isSpace(base[pos])) pos++;
+        if (pos == start) return false;
+        rec.sequence = string_view(base + start, pos - start);
+
+        skipSpace();
+        bool negative = false;
+        if (pos < size && (base[pos] == '-' || base[pos] == '+')) negative = (base[pos++] == '-');
+        size_t digitsStart = pos;
+        long value = 0;
+        while (pos < size && base[pos] >= '0' && base[pos] <= '9') value = value * 10 + (base[pos++] - '0');
+        if (pos == digitsStart) return false;
+        rec.dnaClass = (int)(negative ? -value : value);
+        return true;
+    }
+
+    size_t mappedBytes() const { return size; }
+
+private:
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+    void skipSpace() { while (pos < size && isSpace(base[pos])) pos++; }
+
+    int fd = -1;
+    const char* base = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+};
+
+long getPeakRSS() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss; // Kilobytes (KB)
+}
+
+// RSS saat ini (bukan puncak), untuk memastikan pemindaian mmap tetap datar
+long getCurrentRSS() {
+    long pages = 0, resident = 0;
+    ifstream statm("/proc/self/statm");
+    if (!(statm >> pages >> resident)) return 0;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// ==========================================
+// FASTA / FASTQ STREAMING
+// ==========================================
+// File dibaca per blok besar ke satu buffer yang dipakai ulang; sekuens
+// multi-baris disambung langsung ke string milik pemanggil (kapasitasnya juga
+// dipakai ulang), jadi setelah record pertama hampir tidak ada alokasi.
+// Huruf kecil (soft-masking) dijadikan huruf besar dan dihitung di softMasked.
+struct FastxRecord {
+    string name;
+    string sequence;
+    size_t softMasked = 0;
+};
+
+class FastxReader {
+public:
+    explicit FastxReader(size_t bufferSize = 4 << 20) : buffer(bufferSize) {}
+    FastxReader(const FastxReader&) = delete;
+    FastxReader& operator=(const FastxReader&) = delete;
+    ~FastxReader() { closeFile(); }
+
+    // "-" = stdin
+    bool open(const string& path) {
+        closeFile();
+        fd = (path == "-") ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+        ownsFd = fd >= 0 && fd != STDIN_FILENO;
+        pos = end = 0;
+        eof = false;
+        totalBytes = 0;
+        return fd >= 0;
+    }
+
+    // Record berikutnya (FASTA '>' atau FASTQ '@'); baris lain sebelum header dilewati
+    bool next(FastxRecord& rec) {
+        rec.name.clear();
+        rec.sequence.clear();
+        rec.softMasked = 0;
+
+        int c;
+        while ((c = peek()) >= 0 && c != '>' && c != '@') readLine(nullptr);
+        if (c < 0) return false;
+        pos++;
+        readLine(&rec.name);
+
+        // FASTA berhenti di header berikutnya, FASTQ di baris '+'
+        char stop = (c == '>') ? '>' : '+';
+        while ((c = peek()) >= 0 && c != stop) rec.softMasked += readSequenceLine(rec.sequence);
+        if (stop == '+' && c == '+') {
+            readLine(nullptr);
+            // Kualitas dibaca berdasarkan panjang, karena baris kualitas boleh diawali '@'
+            size_t quality = 0;
+            while (quality < rec.sequence.size() && peek() >= 0) quality += readLine(nullptr);
+        }
+        return true;
+    }
+
+    uint64_t bytesRead() const { return totalBytes; }
+    size_t bufferSize() const { return buffer.size(); }
+
+private:
+    int peek() {
+        if (pos == end && !refill()) return -1;
+        return (unsigned char)buffer[pos];
+    }
+
+    bool refill() {
+        if (eof) return false;
+        while (true) {
+            ssize_t got = read(fd, buffer.data(), buffer.size());
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) {
+                eof = true;
+                return false;
+            }
+            pos = 0;
+            end = (size_t)got;
+            totalBytes += end;
+            return true;
+        }
+    }
+
+    // Tambahkan satu baris (tanpa '\n' dan '\r') ke out, atau lewati jika out = nullptr.
+    // Nilai kembali = panjang baris.
+    size_t readLine(string* out) {
+        size_t length = 0;
+        char last = 0;
+        while (pos < end || refill()) {
+            const char* start = buffer.data() + pos;
+            const char* newline = (const char*)memchr(start, '\n', end - pos);
+            size_t chunk = newline ? (size_t)(newline - start) : end - pos;
+            if (out != nullptr) out->append(start, chunk);
+            if (chunk > 0) last = start[chunk - 1];
+            length += chunk;
+            pos += chunk;
+            if (newline) {
+                pos++;
+                break;
+            }
+        }
+        if (last == '\r') {
+            length--;
+            if (out != nullptr) out->pop_back();
+        }
+        return length;
+    }
+
+    // Seperti readLine, tetapi sekalian huruf besar + buang spasi/'\r' dalam satu
+    // lintasan tanpa cabang. Nilai kembali = jumlah basa huruf kecil.
+    size_t readSequenceLine(string& out) {
+        static const SequenceByteTable table;
+        size_t masked = 0;
+        while (pos < end || refill()) {
+            const char* start = buffer.data() + pos;
+            const char* newline = (const char*)memchr(start, '\n', end - pos);
+            size_t chunk = newline ? (size_t)(newline - start) : end - pos;
+            size_t old = out.size();
+            out.resize(old + chunk);
+            char* dst = &out[old];
+            size_t w = 0;
+            for (size_t r = 0; r < chunk; r++) {
+                unsigned char c = start[r];
+                dst[w] = table.upper[c];
+                w += table.keep[c];
+                masked += table.lower[c];
+            }
+            out.resize(old + w);
+            pos += chunk;
+            if (newline) {
+                pos++;
+                break;
+            }
+        }
+        return masked;
+    }
+
+    struct SequenceByteTable {
+        char upper[256];
+        uint8_t keep[256];      // 0 untuk spasi, '\r', dan kontrol
+        uint8_t lower[256];     // 1 untuk huruf kecil (soft-masked)
+        SequenceByteTable() {
+            for (int c = 0; c < 256; c++) {
+                bool isLower = c >= 'a' && c <= 'z';
+                upper[c] = (char)(isLower ? c - ('a' - 'A') : c);
+                keep[c] = c > ' ';
+                lower[c] = isLower;
+            }
+        }
+    };
+
+    void closeFile() {
+        if (ownsFd) close(fd);
+        fd = -1;
+        ownsFd = false;
+    }
+
+    vector<char> buffer;
+    int fd = -1;
+    bool ownsFd = false;
+    size_t pos = 0;
+    size_t end = 0;
+    bool eof = false;
+    uint64_t totalBytes = 0;
+};
+
+// Sumber record mode analisis: format "sequence class" (mmap, seperti
+// human.txt) atau FASTA/FASTQ (streaming, dideteksi dari '>' / '@' pertama).
+// Record FASTA/FASTQ tidak punya kelas, dnaClass = -1.
+class RecordSource {
+public:
+    bool open(const string& path) {
+        fastx = detectFastx(path);
+        return fastx ? reader.open(path) : corpus.open(path.c_str());
+    }
+
+    // Sekuens FASTA/FASTQ ditulis ke storage dan rec.sequence menunjuk ke sana
+    bool next(DnaRecord& rec, FastxRecord& storage) {
+        rec.softMasked = 0;
+        if (!fastx) return corpus.next(rec);
+        if (!reader.next(storage)) return false;
+        rec.sequence = storage.sequence;
+        rec.dnaClass = -1;
+        rec.softMasked = storage.softMasked;
+        return true;
+    }
+
+    bool isFastx() const { return fastx; }
+
+    string describe() const {
+        if (!fastx) return "Corpus (mmap): " + to_string(corpus.mappedBytes()) + " Byte";
+        return "FASTA/FASTQ (stream): " + to_string(reader.bytesRead()) + " Byte dibaca, buffer "
+             + to_string(reader.bufferSize()) + " Byte";
+    }
+
+private:
+    static bool detectFastx(const string& path) {
+        if (path == "-") return true;
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        char head[4096];
+        ssize_t got = read(fd, head, sizeof(head));
+        close(fd);
+        for (ssize_t i = 0; i < got; i++) {
+            if (head[i] == ' ' || head[i] == '\n' || head[i] == '\r' || head[i] == '\t') continue;
+            return head[i] == '>' || head[i] == '@';
+        }
+        return false;
+    }
+
+    bool fastx = false;
+    MappedCorpus corpus;
+    FastxReader reader;
+};
+
+// ==========================================
+// GENERATOR WORKLOAD SINTETIS
+// ==========================================
+// Teks uji dibuat deterministik dari seed dan dikeluarkan potong demi potong
+// (read), jadi ukurannya boleh jauh di atas 4 GB tanpa pernah ditampung utuh.
+// Hasilnya tidak bergantung pada ukuran potongan. Pola bisa ditanam di offset
+// yang diketahui untuk memeriksa kebenaran engine pada skala besar.
+enum class WorkloadKind { Uniform, Markov, Repeat };
+
+const char* workloadKindName(WorkloadKind kind) {
+    switch (kind) {
+        case WorkloadKind::Uniform: return "uniform";
+        case WorkloadKind::Markov:  return "markov";
+        case WorkloadKind::Repeat:  return "repeat";
+    }
+    return "?";
+}
+
+bool parseWorkloadKind(const string& name, WorkloadKind& kind) {
+    for (WorkloadKind k : {WorkloadKind::Uniform, WorkloadKind::Markov, WorkloadKind::Repeat}) {
+        if (name == workloadKindName(k)) {
+            kind = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Peluang basa berikutnya (A, C, G, T) per basa sebelumnya: perkiraan
+// frekuensi dinukleotida genom manusia (GC ~41%, CpG jarang)
+const array<array<double, 4>, 4> HUMAN_MARKOV = {{
+    {{0.33, 0.17, 0.24, 0.26}},
+    {{0.35, 0.26, 0.05, 0.34}},
+    {{0.29, 0.21, 0.26, 0.24}},
+    {{0.22, 0.20, 0.25, 0.33}},
+}};
+
+struct WorkloadSpec {
+    WorkloadKind kind = WorkloadKind::Uniform;
+    uint64_t length = 1 << 20;
+    uint64_t seed = 42;
+    array<array<double, 4>, 4> transitions = HUMAN_MARKOV;  // Markov orde 1
+    string motif = "CAG";       // Repeat: unit tandem repeat (ACGT)
+    double mutationRate = 0;    // Repeat: peluang substitusi per basa, 0 = repeat sempurna (adversarial)
+    string plant;               // pola yang ditanam, kosong = tidak ada
+    uint64_t plantCount = 0;
+};
+
+// Satu byte acak -> 4 basa (bit rendah = basa pertama), untuk generator uniform
+const array<array<char, 4>, 256> BASE_QUADS = [] {
+    array<array<char, 4>, 256> quads;
+    for (int v = 0; v < 256; v++) {
+        for (int b = 0; b < 4; b++) quads[v][b] = "ACGT"[(v >> (2 * b)) & 3];
+    }
+    return quads;
+}();
+
+class WorkloadGenerator {
+public:
+    explicit WorkloadGenerator(const WorkloadSpec& spec) : spec(spec), rng(spec.seed) {
+        // Tabel basa berikutnya per draw 12 bit (resolusi peluang 1/4096), tanpa cabang saat generate
+        for (int p = 0; p < 4; p++) {
+            double total = 0, sum = 0;
+            for (double v : spec.transitions[p]) total += max(0.0, v);
+            uint32_t from = 0;
+            for (int c = 0; c < 4; c++) {
+                sum += max(0.0, spec.transitions[p][c]);
+                uint32_t to = (total > 0) ? (uint32_t)min(4096.0, sum / total * 4096.0 + 0.5) : (uint32_t)(c + 1) << 10;
+                if (c == 3) to = 4096;
+                for (; from < to; from++) markovNext[p][from] = (uint8_t)c;
+            }
+        }
+        mutationThreshold = (uint32_t)min(65535.0, max(0.0, spec.mutationRate) * 65536.0);
+        if (this->spec.motif.empty()) this->spec.motif = "A";
+        placePlants();
+    }
+
+    // Isi buf dengan basa berikutnya; 0 = teks sudah habis
+    size_t read(char* buf, size_t capacity) {
+        size_t n = (size_t)min<uint64_t>(capacity, spec.length - pos);
+        size_t i = 0;
+        while (i < n) {
+            uint64_t at = pos + i;
+            if (nextPlant < offsets.size() && at >= offsets[nextPlant]) {
+                // Di dalam kemunculan yang ditanam (bisa terpotong antar read)
+                size_t into = (size_t)(at - offsets[nextPlant]);
+                size_t take = min(n - i, spec.plant.size() - into);
+                memcpy(buf + i, spec.plant.data() + into, take);
+                i += take;
+                if (into + take == spec.plant.size()) {
+                    int code = baseCode(spec.plant.back());
+                    if (code >= 0) previous = code;
+                    nextPlant++;
+                }
+                continue;
+            }
+            size_t stop = n;
+            if (nextPlant < offsets.size()) stop = (size_t)min<uint64_t>(n, offsets[nextPlant] - pos);
+            fillBackground(buf + i, stop - i, at);
+            i = stop;
+        }
+        pos += n;
+        return n;
+    }
+
+    uint64_t position() const { return pos; }
+    uint64_t remaining() const { return spec.length - pos; }
+    const vector<uint64_t>& plantedOffsets() const { return offsets; }
+
+private:
+    // Bit acak diambil sedikit-sedikit dari satu word 64-bit
+    struct BitPool {
+        uint64_t word = 0;
+        int bits = 0;
+
+        uint32_t draw(mt19937_64& rng, int n) {
+            if (bits < n) {
+                word = rng();
+                bits = 64;
+            }
+            uint32_t v = (uint32_t)(word & ((1ULL << n) - 1));
+            word >>= n;
+            bits -= n;
+            return v;
+        }
+    };
+
+    // State disalin ke lokal selama loop: store ke out (char*) boleh alias
+    // dengan member, jadi member akan dibaca-tulis ulang di setiap basa
+    void fillBackground(char* out, size_t n, uint64_t at) {
+        BitPool bits = pool;
+        auto draw = [&](int count) { return bits.draw(rng, count); };
+        switch (spec.kind) {
+            case WorkloadKind::Uniform: {
+                // Sisa word sebelumnya dulu, lalu 32 basa utuh per word (urutan bit sama dengan draw)
+                size_t k = 0;
+                for (; k < n && bits.bits > 0; k++) out[k] = "ACGT"[draw(2)];
+                for (; k + 32 <= n; k += 32) {
+                    uint64_t word = rng();
+                    for (int b = 0; b < 8; b++) memcpy(out + k + 4 * b, BASE_QUADS[(word >> (8 * b)) & 0xFF].data(), 4);
+                }
+                for (; k < n; k++) out[k] = "ACGT"[draw(2)];
+                break;
+            }
+            case WorkloadKind::Markov: {
+                int prev = previous;
+                for (size_t k = 0; k < n; k++) {
+                    prev = markovNext[prev][draw(12)];
+                    out[k] = "ACGT"[prev];
+                }
+                previous = prev;
+                break;
+            }
+            case WorkloadKind::Repeat: {
+                // Fase motif mengikuti posisi absolut, jadi pola tanam tidak menggeser repeat
+                size_t period = spec.motif.size();
+                size_t phase = (size_t)(at % period);
+                for (size_t k = 0; k < n; k++) {
+                    char c = spec.motif[phase];
+                    if (++phase == period) phase = 0;
+                    if (mutationThreshold > 0 && draw(16) < mutationThreshold) {
+                        int code = max(0, baseCode(c));
+                        c = "ACGT"[(code + 1 + draw(16) % 3) & 3];
+                    }
+                    out[k] = c;
+                }
+                break;
+            }
+        }
+        pool = bits;
+    }
+
+    // Satu kemunculan per slot panjang/jumlah, offset acak di dalam slot,
+    // jadi tidak ada yang tumpang tindih dan urutannya sudah naik
+    void placePlants() {
+        size_t m = spec.plant.size();
+        if (m == 0 || spec.plantCount == 0 || spec.length < m) return;
+        uint64_t count = min<uint64_t>(spec.plantCount, spec.length / m);
+        uint64_t slot = spec.length / count;
+        mt19937_64 placeRng(spec.seed ^ 0x9E3779B97F4A7C15ULL);
+        offsets.reserve(count);
+        for (uint64_t k = 0; k < count; k++) offsets.push_back(k * slot + placeRng() % (slot - m + 1));
+    }
+
+    WorkloadSpec spec;
+    mt19937_64 rng;
+    BitPool pool;
+    uint8_t markovNext[4][4096];
+    uint32_t mutationThreshold = 0;
+    int previous = 0;                 // basa terakhir (Markov)
+    uint64_t pos = 0;
+    vector<uint64_t> offsets;
+    size_t nextPlant = 0;
+};
+
+// Seluruh teks ke satu buffer: resize sekali lalu ditulis di tempat, tanpa salinan kedua
+vector<uint64_t> generateWorkload(const WorkloadSpec& spec, string& out) {
+    WorkloadGenerator gen(spec);
+    out.resize((size_t)spec.length);
+    gen.read(&out[0], out.size());
+    return gen.plantedOffsets();
+}
+
+// Streaming ke file atau stdout ("-") per potongan chunkSize; false jika gagal menulis
+bool writeWorkload(const WorkloadSpec& spec, const string& path, size_t chunkSize, vector<uint64_t>* offsets = nullptr) {
+    int fd = (path == "-") ? STDOUT_FILENO : open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    WorkloadGenerator gen(spec);
+    vector<char> buffer(max<size_t>(1, chunkSize));
+    bool ok = true;
+    for (size_t got; ok && (got = gen.read(buffer.data(), buffer.size())) > 0;) {
+        for (size_t done = 0; done < got;) {
+            ssize_t w = write(fd, buffer.data() + done, got - done);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) {
+                ok = false;
+                break;
+            }
+            done += (size_t)w;
+        }
+    }
+    if (fd != STDOUT_FILENO && close(fd) != 0) ok = false;
+    if (offsets) *offsets = gen.plantedOffsets();
+    return ok;
+}
+
+// ==========================================
+// FM-INDEX (SUFFIX ARRAY + BWT)
+// ==========================================
+// Semua record digabung menjadi satu teks: A=1 C=2 G=3 T=4, basa lain dan
+// pemisah antar record = 5, sentinel 0 di akhir. Suffix array dibangun dengan
+// SA-IS, lalu BWT disimpan sebagai bitmask per simbol + rank tiap 64 baris
+// (rank = popcount). SA disampel setiap FM_SAMPLE_RATE posisi teks untuk locate.
+// SA dibangun dengan int32, jadi korpus dibatasi < 2 Gi basa.
+const uint32_t FM_SYMBOLS = 5;      // simbol 1..5 (sentinel tidak punya kolom rank)
+const uint32_t FM_SAMPLE_RATE = 32;
+const char FM_MAGIC[8] = {'P', 'A', 'A', 'F', 'M', 'I', 'D', '1'};
+
+struct FmBlock {
+    uint32_t rank[FM_SYMBOLS];      // jumlah simbol sebelum blok ini
+    uint32_t sampledRank;           // jumlah baris tersampel sebelum blok ini
+    uint64_t bits[FM_SYMBOLS];      // baris di blok dengan BWT = simbol
+    uint64_t sampled;               // baris di blok yang nilai SA-nya disimpan
+};
+
+struct FmHeader {
+    char magic[8];
+    uint64_t length;                // panjang teks termasuk sentinel
+    uint64_t blockCount;
+    uint64_t sampleCount;
+    uint64_t recordCount;
+    uint64_t C[FM_SYMBOLS + 2];     // C[c] = jumlah simbol < c
+};
+
+inline uint32_t fmCode(char c) {
+    int code = baseCode(c);
+    return code < 0 ? 5 : code + 1;
+}
+
+// --- SA-IS (Nong, Zhang & Chan) ---
+void saisBuckets(const int32_t* s, int n, int K, vector<int32_t>& bkt, bool end) {
+    fill(bkt.begin(), bkt.end(), 0);
+    for (int i = 0; i < n; i++) bkt[s[i]]++;
+    int sum = 0;
+    for (int c = 0; c <= K; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+void saisInduce(const int32_t* s, int32_t* SA, const vector<bool>& stype, int n, int K, vector<int32_t>& bkt) {
+    saisBuckets(s, n, K, bkt, false);
+    for (int i = 0; i < n; i++) {
+        int j = SA[i] - 1;
+        if (SA[i] > 0 && !stype[j]) SA[bkt[s[j]]++] = j;
+    }
+    saisBuckets(s, n, K, bkt, true);
+    for (int i = n - 1; i >= 0; i--) {
+        int j = SA[i] - 1;
+        if (SA[i] > 0 && stype[j]) SA[--bkt[s[j]]] = j;
+    }
+}
+
+// s[n-1] harus sentinel unik dan terkecil (0); simbol lain di [1, K]
+void saisBuild(const int32_t* s, int32_t* SA, int n, int K) {
+    if (n == 1) {
+        SA[0] = 0;
+        return;
+    }
+    vector<bool> stype(n);
+    stype[n - 1] = true;
+    for (int i = n - 2; i >= 0; i--) stype[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && stype[i + 1]);
+    auto isLMS = [&](int i) { return i > 0 && stype[i] && !stype[i - 1]; };
+
+    // 1. Urutkan substring LMS
+    vector<int32_t> bkt(K + 1);
+    saisBuckets(s, n, K, bkt, true);
+    fill(SA, SA + n, -1);
+    for (int i = 1; i < n; i++) if (isLMS(i)) SA[--bkt[s[i]]] = i;
+    saisInduce(s, SA, stype, n, K, bkt);
+
+    // 2. Beri nama substring LMS, susun string tereduksi di ujung SA
+    int n1 = 0;
+    for (int i = 0; i < n; i++) if (isLMS(SA[i])) SA[n1++] = SA[i];
+    fill(SA + n1, SA + n, -1);
+    int name = 0, prev = -1;
+    for (int i = 0; i < n1; i++) {
+        int pos = SA[i];
+        bool diff = false;
+        for (int d = 0; d < n; d++) {
+            if (prev == -1 || s[pos + d] != s[prev + d] || stype[pos + d] != stype[prev + d]) {
+                diff = true;
+                break;
+            } else if (d > 0 && (isLMS(pos + d) || isLMS(prev + d))) {
+                break;
+            }
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        SA[n1 + pos / 2] = name - 1;
+    }
+    for (int i = n - 1, j = n - 1; i >= n1; i--) if (SA[i] >= 0) SA[j--] = SA[i];
+
+    // 3. Rekursi jika nama belum unik
+    int32_t* s1 = SA + n - n1;
+    int32_t* SA1 = SA;
+    if (name < n1) saisBuild(s1, SA1, n1, name - 1);
+    else for (int i = 0; i < n1; i++) SA1[s1[i]] = i;
+
+    // 4. Induksi SA akhir dari urutan LMS
+    saisBuckets(s, n, K, bkt, true);
+    for (int i = 1, j = 0; i < n; i++) if (isLMS(i)) s1[j++] = i;
+    for (int i = 0; i < n1; i++) SA1[i] = s1[SA1[i]];
+    fill(SA + n1, SA + n, -1);
+    for (int i = n1 - 1; i >= 0; i--) {
+        int j = SA[i];
+        SA[i] = -1;
+        SA[--bkt[s[j]]] = j;
+    }
+    saisInduce(s, SA, stype, n, K, bkt);
+}
+
+struct FmLocation {
+    uint64_t record;
+    uint64_t offset;
+};
+
+// View read-only di atas file index yang di-mmap (atau buffer lain)
+class FmIndex {
+public:
+    FmIndex() = default;
+    FmIndex(const FmIndex&) = delete;
+    FmIndex& operator=(const FmIndex&) = delete;
+
+    ~FmIndex() {
+        if (mapped != nullptr) munmap(mapped, mappedSize);
+    }
+
+    bool load(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(FmHeader);
+        if (ok) {
+            mappedSize = st.st_size;
+            mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                mapped = nullptr;
+                ok = false;
+            }
+        }
+        close(fd);
+        if (!ok) return false;
+
+        const char* base = (const char*)mapped;
+        header = (const FmHeader*)base;
+        if (memcmp(header->magic, FM_MAGIC, sizeof(FM_MAGIC)) != 0) return false;
+        size_t offset = sizeof(FmHeader);
+        blocks = (const FmBlock*)(base + offset);
+        offset += header->blockCount * sizeof(FmBlock);
+        samples = (const uint32_t*)(base + offset);
+        offset += ((header->sampleCount * sizeof(uint32_t) + 7) / 8) * 8;
+        recordStart = (const uint64_t*)(base + offset);
+        offset += (header->recordCount + 1) * sizeof(uint64_t);
+        return offset <= mappedSize;
+    }
+
+    // Jumlah kemunculan pola (hanya ACGT); O(m) lewat backward search
+    uint64_t count(string_view pattern, uint64_t* spOut = nullptr, uint64_t* epOut = nullptr) const {
+        uint64_t sp = 0, ep = header->length;
+        for (size_t k = pattern.length(); k-- > 0 && sp < ep;) {
+            uint32_t c = fmCode(pattern[k]);
+            if (c == 5) return 0;
+            sp = header->C[c] + rank(c, sp);
+            ep = header->C[c] + rank(c, ep);
+        }
+        if (spOut != nullptr) *spOut = sp;
+        if (epOut != nullptr) *epOut = ep;
+        return (sp < ep) ? ep - sp : 0;
+    }
+
+    void locate(string_view pattern, vector<FmLocation>& out) const {
+        uint64_t sp = 0, ep = 0;
+        if (count(pattern, &sp, &ep) == 0) return;
+        for (uint64_t row = sp; row < ep; row++) {
+            uint64_t pos = textPosition(row);
+            const uint64_t* it = upper_bound(recordStart, recordStart + header->recordCount + 1, pos);
+            uint64_t record = (it - recordStart) - 1;
+            out.push_back({record, pos - recordStart[record]});
+        }
+    }
+
+    uint64_t length() const { return header->length; }
+    uint64_t records() const { return header->recordCount; }
+    size_t sizeInBytes() const { return mappedSize; }
+
+private:
+    uint64_t rank(uint32_t c, uint64_t row) const {
+        const FmBlock& b = blocks[row / 64];
+        uint64_t below = (row % 64 == 0) ? 0 : (b.bits[c - 1] << (64 - row % 64));
+        return b.rank[c - 1] + __builtin_popcountll(below);
+    }
+
+    // Jalan LF sampai baris tersampel; baris sentinel (SA = 0) selalu tersampel
+    uint64_t textPosition(uint64_t row) const {
+        uint64_t steps = 0;
+        while (true) {
+            const FmBlock& b = blocks[row / 64];
+            uint64_t bit = 1ULL << (row % 64);
+            if (b.sampled & bit) {
+                uint64_t below = b.sampled & (bit - 1);
+                return samples[b.sampledRank + __builtin_popcountll(below)] + steps;
+            }
+            uint32_t c = 1;
+            while (!(b.bits[c - 1] & bit)) c++;
+            row = header->C[c] + rank(c, row);
+            steps++;
+        }
+    }
+
+    void* mapped = nullptr;
+    size_t mappedSize = 0;
+    const FmHeader* header = nullptr;
+    const FmBlock* blocks = nullptr;
+    const uint32_t* samples = nullptr;
+    const uint64_t* recordStart = nullptr;
+};
+
+// Bangun index dari seluruh record sumber (korpus mmap atau FASTA/FASTQ) dan tulis ke file biner
+bool buildFmIndex(RecordSource& source, const string& path, uint64_t& recordCount) {
+    vector<int32_t> text;
+    vector<uint64_t> recordStart;
+    DnaRecord rec;
+    FastxRecord storage;
+    while (source.next(rec, storage)) {
+        if (!text.empty()) text.push_back(5);
+        recordStart.push_back(text.size());
+        for (char c : rec.sequence) text.push_back(fmCode(c));
+    }
+    recordStart.push_back(text.size());
+    text.push_back(0);
+    recordCount = recordStart.size() - 1;
+    if (text.size() >= (1ULL << 31)) {
+        cout << "Error: korpus terlalu besar untuk index 32-bit." << endl;
+        return false;
+    }
+
+    int n = text.size();
+    vector<int32_t> SA(n);
+    saisBuild(text.data(), SA.data(), n, FM_SYMBOLS);
+
+    FmHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FM_MAGIC, sizeof(FM_MAGIC));
+    header.length = n;
+    header.blockCount = n / 64 + 1;
+    header.recordCount = recordCount;
+    for (int i = 0; i < n; i++) header.C[text[i] + 1]++;
+    for (uint32_t c = 1; c < FM_SYMBOLS + 2; c++) header.C[c] += header.C[c - 1];
+
+    vector<FmBlock> blocks(header.blockCount);
+    vector<uint32_t> samples;
+    uint32_t running[FM_SYMBOLS] = {0, 0, 0, 0, 0};
+    uint32_t sampledSoFar = 0;
+    for (int i = 0; i < n; i++) {
+        FmBlock& b = blocks[i / 64];
+        if (i % 64 == 0) {
+            memcpy(b.rank, running, sizeof(running));
+            b.sampledRank = sampledSoFar;
+        }
+        uint64_t bit = 1ULL << (i % 64);
+        int32_t sym = (SA[i] == 0) ? 0 : text[SA[i] - 1];
+        if (sym > 0) {
+            b.bits[sym - 1] |= bit;
+            running[sym - 1]++;
+        }
+        if (SA[i] % FM_SAMPLE_RATE == 0) {
+            b.sampled |= bit;
+            samples.push_back(SA[i]);
+            sampledSoFar++;
+        }
+    }
+    if (n % 64 == 0) {
+        memcpy(blocks.back().rank, running, sizeof(running));
+        blocks.back().sampledRank = sampledSoFar;
+    }
+    header.sampleCount = samples.size();
+
+    ofstream out(path, ios::binary);
+    if (!out.is_open()) return false;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)blocks.data(), blocks.size() * sizeof(FmBlock));
+    out.write((const char*)samples.data(), samples.size() * sizeof(uint32_t));
+    if (samples.size() % 2 == 1) {
+        uint32_t pad = 0;
+        out.write((const char*)&pad, sizeof(pad));
+    }
+    out.write((const char*)recordStart.data(), recordStart.size() * sizeof(uint64_t));
+    return out.good();
+}
+
+// ==========================================
+// HARDWARE PERFORMANCE COUNTER (perf_event_open)
+// ==========================================
+// Setiap counter dibuka terpisah (bukan group) supaya satu event yang tidak
+// didukung (mis. LLC di VM) tidak mematikan yang lain. Hanya user space yang
+// dihitung, jadi cukup perf_event_paranoid <= 2.
+const int PERF_EVENT_COUNT = 5;
+
+class PerfSession {
+public:
+    PerfSession() {
+        const pair<uint32_t, uint64_t> events[PERF_EVENT_COUNT] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},   // last level cache
+        };
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) fds[e] = openEvent(events[e].first, events[e].second);
+    }
+
+    ~PerfSession() {
+        for (int fd : fds) if (fd >= 0) close(fd);
+    }
+
+    PerfSession(const PerfSession&) = delete;
+    PerfSession& operator=(const PerfSession&) = delete;
+
+    bool available() const {
+        for (int fd : fds) if (fd >= 0) return true;
+        return false;
+    }
+
+    void start() {
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    PerfCounters stop() {
+        long long values[PERF_EVENT_COUNT];
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            if (fds[e] >= 0) ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) values[e] = readScaled(fds[e]);
+
+        PerfCounters c;
+        c.valid = available();
+        c.cycles = values[0];
+        c.instructions = values[1];
+        c.branchMisses = values[2];
+        c.l1Misses = values[3];
+        c.llcMisses = values[4];
+        return c;
+    }
+
+private:
+    static int openEvent(uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    // Jika kernel melakukan multiplexing, nilai diskalakan dengan enabled/running
+    static long long readScaled(int fd) {
+        if (fd < 0) return -1;
+        uint64_t data[3];
+        if (read(fd, data, sizeof(data)) != (ssize_t)sizeof(data)) return -1;
+        if (data[2] == 0) return data[1] == 0 ? (long long)data[0] : -1;
+        return (long long)((double)data[0] * data[1] / data[2]);
+    }
+
+    int fds[PERF_EVENT_COUNT];
+};
+
+// Stack diukur dengan stack painting: area tepat di bawah frame pemanggil diisi
+// pola sebelum engine dipanggil, lalu dicari byte terdalam yang tertimpa.
+const size_t STACK_PROBE_BYTES = 64 * 1024;
+const unsigned char STACK_PAINT = 0xA5;
+
+__attribute__((noinline)) uintptr_t paintStack() {
+    unsigned char area[STACK_PROBE_BYTES];
+    memset(area, STACK_PAINT, sizeof(area));
+    // Barrier: compiler tidak boleh membuang memset maupun alamat area
+    uintptr_t bottom = (uintptr_t)area;
+    asm volatile("" : "+r"(bottom) : : "memory");
+    return bottom;
+}
+
+// Granularitas word 8 byte: nilai yang tersimpan (mis. pointer stack) bisa saja
+// berisi byte 0xA5 di bawahnya, sehingga hitungan per byte bergantung alamat
+// stack dan berbeda antara thread.
+__attribute__((noinline)) size_t stackHighWater(uintptr_t bottom) {
+    asm volatile("" : : : "memory");
+    const uint64_t paintWord = 0x0101010101010101ULL * STACK_PAINT;
+    const uint64_t* words = (const uint64_t*)bottom;
+    size_t i = 0;
+    while (i < STACK_PROBE_BYTES / 8 && words[i] == paintWord) i++;
+    return STACK_PROBE_BYTES - i * 8;
+}
+
+// Bungkus satu pemanggilan engine: heap (MemoryProbe), stack (painting) dan,
+// jika ada sesi perf, counter hardware. TOTAL MEM = input + tabel + stack + puncak heap.
+// Setiap panggilan diukur apa adanya, termasuk panggilan pertama (lihat warmUpEngines).
+template <typename Call>
+__attribute__((noinline)) AnalysisResult measureEngine(PerfSession* perf, Call&& call) {
+    // rsp dirapikan ke kelipatan 64 sebelum stack dicat: engine AVX meratakan
+    // frame-nya ke 32 byte, jadi tanpa ini kedalamannya bergantung pada
+    // alignment stack thread pemanggil (thread utama vs worker pipeline)
+    uintptr_t sp = (uintptr_t)__builtin_alloca(16);
+    unsigned char* pad = (unsigned char*)__builtin_alloca(sp & 63);
+    asm volatile("" : : "r"(pad) : "memory");
+    uintptr_t stackBottom = paintStack();
+    MemoryProbe probe;
+    if (perf != nullptr) perf->start();
+    AnalysisResult r = call();
+    if (perf != nullptr) r.perf = perf->stop();
+    r.alloc = probe.stats();
+    r.stackMem = stackHighWater(stackBottom);
+    r.totalMem = r.inputMem + r.lpsMem + r.stackMem + r.alloc.peakLive;
+    return r;
+}
+
+// ==========================================
+// PIPELINE BATCH PARALEL
+// ==========================================
+// Antrian berkapasitas tetap antar tahap pipeline (reader -> worker -> writer).
+// push() menunggu jika penuh sehingga reader tidak berlari jauh di depan.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(T item) {
+        unique_lock<mutex> lock(mtx);
+        notFull.wait(lock, [&] { return items.size() < capacity; });
+        items.push_back(move(item));
+        notEmpty.notify_one();
+    }
+
+    // false jika antrian sudah ditutup dan kosong
+    bool pop(T& item) {
+        unique_lock<mutex> lock(mtx);
+        notEmpty.wait(lock, [&] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Tanpa menunggu; false jika antrian sedang kosong
+    bool tryPop(T& item) {
+        lock_guard<mutex> lock(mtx);
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> lock(mtx);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    size_t capacity;
+    deque<T> items;
+    bool closed = false;
+    mutex mtx;
+    condition_variable notEmpty, notFull;
+};
+
+// Output dikumpulkan di buffer besar dan ditulis per blok, bukan di-flush per baris
+class OutputBuffer {
+public:
+    explicit OutputBuffer(ostream& os, size_t limit = 1 << 20) : os(os), limit(limit) { buf.reserve(limit); }
+    ~OutputBuffer() { flush(); }
+
+    void append(const string& s) {
+        buf += s;
+        if (buf.size() >= limit) write();
+    }
+    void flush() {
+        write();
+        os.flush();
+    }
+
+private:
+    void write() {
+        os.write(buf.data(), buf.size());
+        buf.clear();
+    }
+
+    ostream& os;
+    size_t limit;
+    string buf;
+};
+
+// ==========================================
+// BATCH TILED (BANYAK POLA x BANYAK RECORD)
+// ==========================================
+// Loop "for pola: for record" membaca ulang seluruh korpus dari memori untuk
+// setiap pola. Di sini record berurutan dikelompokkan menjadi tile seukuran
+// cache L2, lalu semua pola dijalankan atas satu tile selagi tile itu masih
+// panas di cache, jadi korpus hanya sekali dibaca dari DRAM. Tile dibagi antar
+// core lewat satu counter atomik. Setiap tile menulis kolom matriks yang
+// berbeda, jadi tidak perlu lock.
+
+// Matriks hitungan padat pola x record, baris per pola
+struct CountMatrix {
+    size_t patterns = 0;
+    size_t records = 0;
+    vector<uint32_t> counts;
+
+    void reset(size_t patternCount, size_t recordCount) {
+        patterns = patternCount;
+        records = recordCount;
+        counts.assign(patternCount * recordCount, 0);
+    }
+
+    uint32_t& at(size_t p, size_t r) { return counts[p * records + r]; }
+    uint32_t at(size_t p, size_t r) const { return counts[p * records + r]; }
+    size_t memory() const { return counts.capacity() * sizeof(uint32_t); }
+};
+
+struct RecordTile {
+    size_t first;   // record [first, last)
+    size_t last;
+    size_t bytes;
+};
+
+// Ukuran L2 per core dari sysconf; 1 MiB jika tidak dilaporkan
+size_t l2CacheBytes() {
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    return size > 0 ? (size_t)size : (size_t)1 << 20;
+}
+
+// Record digabung sampai tileBytes; record yang lebih besar dari tile menjadi tile sendiri
+vector<RecordTile> buildRecordTiles(const vector<string_view>& records, size_t tileBytes) {
+    vector<RecordTile> tiles;
+    RecordTile current = {0, 0, 0};
+    for (size_t r = 0; r < records.size(); r++) {
+        if (current.last > current.first && current.bytes + records[r].size() > tileBytes) {
+            tiles.push_back(current);
+            current = {r, r, 0};
+        }
+        current.last = r + 1;
+        current.bytes += records[r].size();
+    }
+    if (current.last > current.first) tiles.push_back(current);
+    return tiles;
+}
+
+// Baseline: setiap pola memindai seluruh korpus; threads worker mengambil pola bergiliran
+template <typename Search>
+void countNested(const vector<string_view>& records, const vector<CompiledPattern>& patterns,
+                 CountMatrix& matrix, int threads, Search&& search) {
+    atomic<size_t> nextPattern(0);
+    auto worker = [&] {
+        for (size_t p; (p = nextPattern.fetch_add(1, memory_order_relaxed)) < patterns.size();) {
+            for (size_t r = 0; r < records.size(); r++) matrix.at(p, r) = (uint32_t)search(records[r], patterns[p]).matches;
+        }
+    };
+    if (threads <= 1) {
+        worker();
+        return;
+    }
+    vector<thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+}
+
+// Semua pola atas satu tile sebelum pindah ke tile berikutnya; threads worker mengambil tile bergiliran
+template <typename Search>
+void countTiled(const vector<string_view>& records, const vector<RecordTile>& tiles,
+                const vector<CompiledPattern>& patterns, CountMatrix& matrix, int threads, Search&& search) {
+    atomic<size_t> nextTile(0);
+    auto worker = [&] {
+        for (size_t t; (t = nextTile.fetch_add(1, memory_order_relaxed)) < tiles.size();) {
+            const RecordTile& tile = tiles[t];
+            for (size_t p = 0; p < patterns.size(); p++) {
+                for (size_t r = tile.first; r < tile.last; r++) matrix.at(p, r) = (uint32_t)search(records[r], patterns[p]).matches;
+            }
+        }
+    };
+    if (threads <= 1) {
+        worker();
+        return;
+    }
+    vector<thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+}
+
+// ==========================================
+// SPEKTRUM K-MER PER KELAS
+// ==========================================
+// Setiap record di-roll sekali dengan jendela 2-bit (k <= 31, jadi ~0 bebas
+// dipakai sebagai slot kosong). K-mer ditampung dulu di buffer lokal per
+// thread, satu baris tetap per shard, lalu dimasukkan per batch ke tabel
+// kelasnya. Tabel kelas dibagi 64 shard menurut hash k-mer, masing-masing
+// dengan mutex sendiri, jadi thread hanya bertabrakan jika mengisi shard yang
+// sama pada saat yang sama. Tidak ada alokasi per k-mer: alokasi hanya
+// terjadi saat tabel shard tumbuh (dua kali lipat).
+const int KMER_MAX_K = 31;
+const int KMER_SHARD_BITS = 6;
+const int KMER_SHARDS = 1 << KMER_SHARD_BITS;
+const char KMER_MAGIC[8] = {'P', 'A', 'A', 'K', 'M', 'E', 'R', '1'};
+
+inline int kmerShard(uint64_t kmer) {
+    return (int)((kmer * 0x9E3779B97F4A7C15ULL) >> (64 - KMER_SHARD_BITS));
+}
+
+string kmerToString(uint64_t kmer, int k) {
+    string s(k, 'A');
+    for (int i = k - 1; i >= 0; i--, kmer >>= 2) s[i] = "ACGT"[kmer & 3];
+    return s;
+}
+
+// Open addressing (linear probing), load <= 0.5; satu shard, dipakai di bawah lock.
+// Kunci dan count satu slot berdampingan, jadi satu insert menyentuh satu cache line.
+class KmerCountTable {
+public:
+    static constexpr uint64_t EMPTY = ~0ULL;
+
+    // Batch dari KmerBatch: slot beberapa k-mer di depan di-prefetch selagi yang sekarang diisi
+    void addBatch(const uint64_t* kmers, size_t n) {
+        if (slots.empty()) slots.assign(64, Slot{EMPTY, 0});
+        const size_t AHEAD = 8;
+        for (size_t i = 0; i < n; i++) {
+            if (i + AHEAD < n) __builtin_prefetch(&slots[homeSlot(kmers[i + AHEAD])], 1);
+            add(kmers[i]);
+        }
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const Slot& s : slots) {
+            if (s.key != EMPTY) f(s.key, s.count);
+        }
+    }
+
+    size_t size() const { return used; }
+    size_t memory() const { return slots.capacity() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        uint64_t key;
+        uint64_t count;
+    };
+
+    // Bit hash yang berbeda dari pemilih shard, supaya slot tetap tersebar
+    size_t homeSlot(uint64_t kmer) const {
+        return (size_t)((kmer * 0xC2B2AE3D27D4EB4FULL) >> 20) & (slots.size() - 1);
+    }
+
+    size_t probe(uint64_t kmer) const {
+        size_t mask = slots.size() - 1;
+        size_t slot = homeSlot(kmer);
+        while (slots[slot].key != EMPTY && slots[slot].key != kmer) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void add(uint64_t kmer) {
+        size_t slot = probe(kmer);
+        if (slots[slot].key == EMPTY) {
+            // Kunci baru: jaga load <= 0.5, tabel dua kali lipat bila perlu
+            if ((used + 1) * 2 > slots.size()) {
+                grow();
+                slot = probe(kmer);
+            }
+            slots[slot].key = kmer;
+            used++;
+        }
+        slots[slot].count++;
+    }
+
+    void grow() {
+        vector<Slot> old = move(slots);
+        slots.assign(old.size() * 2, Slot{EMPTY, 0});
+        for (const Slot& s : old) {
+            if (s.key != EMPTY) slots[probe(s.key)] = s;
+        }
+    }
+
+    vector<Slot> slots;
+    size_t used = 0;
+};
+
+class ShardedKmerCounter {
+public:
+    void addBatch(int shard, const uint64_t* kmers, size_t n) {
+        Shard& s = shards[shard];
+        lock_guard<mutex> lock(s.lock);
+        s.table.addBatch(kmers, n);
+    }
+
+    // Dipanggil setelah semua worker selesai (tanpa lock)
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const Shard& s : shards) s.table.forEach(f);
+    }
+
+    size_t distinct() const {
+        size_t total = 0;
+        for (const Shard& s : shards) total += s.table.size();
+        return total;
+    }
+
+    size_t memory() const {
+        size_t total = sizeof(*this);
+        for (const Shard& s : shards) total += s.table.memory();
+        return total;
+    }
+
+    // Statistik record kelas ini, diisi worker lewat atomik
+    atomic<uint64_t> records{0};
+    atomic<uint64_t> bases{0};
+    atomic<uint64_t> kmers{0};
+
+private:
+    // Satu cache line per shard supaya lock shard tetangga tidak saling berbagi line
+    struct alignas(64) Shard {
+        mutex lock;
+        KmerCountTable table;
+    };
+    Shard shards[KMER_SHARDS];
+};
+
+// Buffer per thread: satu baris tetap per shard, dialokasikan sekali per worker
+class KmerBatch {
+public:
+    static const size_t ROW = 512;
+
+    void push(ShardedKmerCounter& counter, uint64_t kmer) {
+        int shard = kmerShard(kmer);
+        rows[shard][fill[shard]] = kmer;
+        if (++fill[shard] == ROW) {
+            counter.addBatch(shard, rows[shard], ROW);
+            fill[shard] = 0;
+        }
+    }
+
+    void flush(ShardedKmerCounter& counter) {
+        for (int shard = 0; shard < KMER_SHARDS; shard++) {
+            if (fill[shard] == 0) continue;
+            counter.addBatch(shard, rows[shard], fill[shard]);
+            fill[shard] = 0;
+        }
+    }
+
+private:
+    uint64_t rows[KMER_SHARDS][ROW];
+    size_t fill[KMER_SHARDS] = {0};
+};
+
+// Semua k-mer satu record (basa selain ACGT memulai ulang jendela) ke batch
+void countRecordKmers(string_view seq, int k, ShardedKmerCounter& counter, KmerBatch& batch) {
+    const uint64_t mask = (1ULL << (2 * k)) - 1;
+    uint64_t window = 0;
+    int valid = 0;
+    uint64_t kmers = 0;
+    for (char c : seq) {
+        int code = dfaCodes.code[(unsigned char)c];
+        if (code > 3) {
+            valid = 0;
+            continue;
+        }
+        window = ((window << 2) | (uint64_t)code) & mask;
+        if (++valid < k) continue;
+        valid = k;
+        batch.push(counter, window);
+        kmers++;
+    }
+    batch.flush(counter);
+    counter.records.fetch_add(1, memory_order_relaxed);
+    counter.bases.fetch_add(seq.size(), memory_order_relaxed);
+    counter.kmers.fetch_add(kmers, memory_order_relaxed);
+}
+
+// --- Format biner spektrum ---
+// KmerSpectrumHeader, lalu per kelas: KmerClassHeader, topCount x KmerTopEntry
+// (urut count turun), lalu spektrum penuh sebanyak distinct entri berurutan
+// naik menurut k-mer: varint(selisih k-mer dari entri sebelumnya), varint(count).
+struct KmerSpectrumHeader {
+    char magic[8];
+    uint32_t k;
+    uint32_t classCount;
+};
+
+struct KmerClassHeader {
+    int32_t dnaClass;           // -1 untuk record FASTA/FASTQ tanpa kelas
+    uint32_t topCount;
+    uint64_t records;
+    uint64_t bases;
+    uint64_t kmers;
+    uint64_t distinct;
+    uint64_t spectrumBytes;     // panjang bagian varint
+};
+
+struct KmerTopEntry {
+    uint64_t kmer;              // 2 bit per basa, basa pertama di bit tertinggi
+    uint64_t count;
+};
+
+void appendVarint(string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out += (char)(v | 0x80);
+        v >>= 7;
+    }
+    out += (char)v;
+}
+
+// ==========================================
+// ANALISIS KORPUS (human.txt)
+// ==========================================
+const string GENE_PROBE = "ATGTGTGGCATTTGGGCGCTGTTTGGCAGTGATGATTGCCTTTCTGTTCAGTGTCTGAGTGCTATGAAGATTGCACACAGAGGTCCAGATGCATTCCGTTTTGAGAATGTCAATGGATACACCAACTGCTGCTTTGGATTTCACCGGTTGGCGGTAGTTGACCCGCTGTTTGGAATGCAGCCAATTCGAGTGAAGAAATATCCGTATTTGTGGCTCTGTTACAATGGTGAAATCTACAACCATAAGAAGATGCAACAGCATTTTGAATTTGAATACCAGACCAAAGTGGATGGTGAGATAATCCTTCATCTTTATGACAAAGGAGGAATTGAGCAAACAATTTGTATGTTGGATGGTGTGTTTGCATTTGTTTTACTGGATACTGCCAATAAGAAAGTGTTCCTGGGTAGAGATACATATGGAGTCAGACCTTTGTTTAAAGCAATGACAGAAGATGGATTTTTGGCTGTATGTTCAGAAGCTAAAGGTCTTGTTACATTGAAGCACTCCGCGACTCCCTTTTTAAAAGTGGAGCCTTTTCTTCCTGGACACTATGAAGTTTTGGATTTAAAGCCAAATGGCAAAGTTGCATCCGTGGAAATGGTTAAATATCATCACTGTCGGGATGTACCCCTGCACGCCCTCTATGACAATGTGGAGAAACTCTTTCCAGGTTTTGAGATAGAAACTGTGAAGAACAACCTCAGGATCCTTTTTAATAATGCTGTAAAGAAACGTTTGATGACAGACAGAAGGATTGGCTGCCTTTTATCAGGGGGCTTGGACTCCAGCTTGGTTGCTGCCACTCTGTTGAAGCAGCTGAAAGAAGCCCAAGTACAGTATCCTCTCCAGACATTTGCAATTGGCATGGAAGACAGCCCCGATTTACTGGCTGCTAGAAAGGTGGCAGATCATATTGGAAGTGAACATTATGAAGTCCTTTTTAACTCTGAGGAAGGCATTCAGGCTCTGGATGAAGTCATATTTTCCTTGGAAACTTATGACATTACAACAGTTCGTGCTTCAGTAGGTATGTATTTAATTTCCAAGTATATTCGGAAGAACACAGATAGCGTGGTGATCTTCTCTGGAGAAGGATCAGATGAACTTACGCAGGGTTACATATATTTTCACAAGGCTCCTTCTCCTGAAAAAGCCGAGGAGGAGAGTGAGAGGCTTCTGAGGGAACTCTATTTGTTTGATGTTCTCCGCGCAGATCGAACTACTGCTGCCCATGGTCTTGAACTGAGAGTCCCATTTCTAGATCATCGATTTTCTTCCTATTACTTGTCTCTGCCACCAGAAATGAGAATTCCAAAGAATGGGATAGAAAAACATCTCCTGAGAGAGACGTTTGAGGATTCCAATCTGATACCCAAAGAGATTCTCTGGCGACCAAAAGAAGCCTTCAGTGATGGAATAACTTCAGTTAAGAATTCCTGGTTTAAGATTTTACAGGAATACGTTGAACATCAGGTTGATGATGCAATGATGGCAAATGCAGCCCAGAAATTTCCCTTCAATACTCCTAAAACCAAAGAAGGATATTACTACCGTCAAGTCTTTGAACGCCATTACCCAGGCCGGGCTGACTGGCTGAGCCATTACTGGATGCCCAAGTGGATCAATGCCACTGACCCTTCTGCCCGCACGCTGACCCACTACAAGTCAGCTGTCAAAGCTTAG";
+
+string perfValue(long long v) {
+    return v < 0 ? "n/a" : to_string(v);
+}
+
+void printResultRow(ostream& out, const string& no, int dnaClass, const AnalysisResult& r, bool showPerf = false) {
+    out << left << setw(4) << no 
+         << setw(7) << (dnaClass < 0 ? string("-") : to_string(dnaClass)) 
+         << setw(10) << r.algorithm 
+         << setw(12) << perfValue(r.comparisons) 
+         << setw(10) << r.duration 
+         << setw(8) << r.matches 
+         << "| "
+         << setw(10) << r.inputMem 
+         << setw(10) << r.lpsMem 
+         << setw(10) << r.stackMem 
+         << setw(10) << r.alloc.peakLive 
+         << setw(8) << r.alloc.count 
+         << setw(12) << r.totalMem;
+    if (showPerf) {
+        double ipc = r.perf.ipc();
+        out << "| "
+             << setw(12) << perfValue(r.perf.cycles) 
+             << setw(12) << perfValue(r.perf.instructions);
+        if (ipc < 0) out << setw(7) << "n/a";
+        else out << setw(7) << setprecision(2) << ipc << setprecision(4);
+        out << setw(9) << perfValue(r.perf.branchMisses) 
+             << setw(9) << perfValue(r.perf.l1Misses) 
+             << setw(9) << perfValue(r.perf.llcMisses);
+    }
+    out << '\n';
+}
+
+struct AnalysisOptions {
+    bool packed = false;    // --packed : Naive/KMP memakai representasi 2-bit
+    string patternsFile;    // --patterns FILE : mode multi-pattern Aho-Corasick
+    int maxEdits = -1;      // --max-edits K : tambah baris Myers (k edit), -1 = mati
+    bool perf = false;      // --perf : kolom counter hardware per engine
+    string buildIndexFile;  // --build-index FILE : bangun FM-index seluruh korpus
+    string queryIndexFile;  // --query-index FILE : benchmark query FM-index vs KMP
+
+    // --bench : benchmark suite semua engine x semua workload
+    bool bench = false;
+    int warmups = 2;        // --warmup N
+    int trials = 15;        // --trials N
+    int cpu = -1;           // --cpu K (default: CPU tempat proses sedang berjalan)
+    string csvFile;         // --csv FILE
+    string jsonFile;        // --json FILE
+    string baselineFile;    // --baseline FILE (CSV dari run sebelumnya)
+    double threshold = 10;  // --threshold PCT : batas regresi median
+
+    int threads = 1;        // --threads N : worker pencarian paralel (0 = semua core)
+
+    string streamFile;      // --stream FILE|- : KMP streaming atas file/pipe apa adanya
+    size_t chunkSize = 1 << 20;  // --chunk BYTES : ukuran buffer baca mode stream
+
+    string inputFile = "human.txt";  // --input FILE : "sequence class", FASTA atau FASTQ ("-" = stdin)
+
+    bool calibrate = false;             // --calibrate : ukur titik potong dispatcher lalu simpan
+    string dispatchFile = "dispatch.cfg";  // --dispatch FILE : file kalibrasi dispatcher
+
+    bool bothStrands = false;   // --both-strands : tambah baris pencarian pola + reverse complement
+
+    string generateFile;        // --generate FILE|- : tulis teks sintetis lalu keluar
+    WorkloadSpec workload;      // --gen-kind, --gen-length, --seed, --motif, --mutation, --plant-count
+
+    bool tiled = false;         // --tiled : matriks pola (--patterns) x record, tiled vs loop bersarang
+    size_t tileBytes = 0;       // --tile BYTES : ukuran tile, 0 = setengah L2
+    string matrixFile;          // --matrix FILE : tulis matriks hitungan (TSV)
+
+    int kmerLength = 0;         // --kmer K : spektrum k-mer per kelas (1..31), 0 = mati
+    int topKmers = 10;          // --top N
+    string spectrumFile;        // --spectrum FILE : spektrum biner (lihat KmerSpectrumHeader)
+};
+
+const string ROW_SEPARATOR = "----------------------------------------------------------------------------------------------------------------------------------------------------------";
+
+// Semua baris satu record ditulis ke out tanpa flush; dipakai mode serial dan pipeline
+void analyzeRecord(ostream& out, int no, const DnaRecord& rec, const CompiledPattern& pattern,
+                   const EngineDispatcher& dispatcher, const StrandScanner* strands, const AnalysisOptions& opt,
+                   PerfSession* perf, PackedSeq& packedDna) {
+    string_view dna = rec.sequence;
+    int dnaClass = rec.dnaClass;
+    bool showPerf = opt.perf;
+
+    AnalysisResult resNaive, resKMP;
+    if (opt.packed) {
+        packSequenceInto(dna, packedDna);
+        resNaive = measureEngine(perf, [&] { return naiveSearchPacked(packedDna, pattern); });
+        resKMP = measureEngine(perf, [&] { return kmpSearchPacked(packedDna, pattern); });
+    } else {
+        resNaive = measureEngine(perf, [&] { return naiveSearch(dna, pattern); });
+        resKMP = measureEngine(perf, [&] { return kmpSearch(dna, pattern); });
+    }
+
+    printResultRow(out, to_string(no), dnaClass, resNaive, showPerf);
+    printResultRow(out, "", dnaClass, resKMP, showPerf);
+    printResultRow(out, "", dnaClass, measureEngine(perf, [&] { return kmpDfaSearch(dna, pattern); }), showPerf);
+    printResultRow(out, "", dnaClass, measureEngine(perf, [&] { return twoWaySearch(dna, pattern); }), showPerf);
+    printResultRow(out, "", dnaClass, measureEngine(perf, [&] { return simdSearch(dna, pattern); }), showPerf);
+    printResultRow(out, "", dnaClass, measureEngine(perf, [&] { return shiftAndSearch(dna, pattern); }), showPerf);
+    printResultRow(out, "", dnaClass, measureEngine(perf, [&] { return bndmSearch(dna, pattern); }), showPerf);
+    printResultRow(out, "", dnaClass, measureEngine(perf, [&] { return dispatcher.search(dna, pattern); }), showPerf);
+    if (strands) {
+        AnalysisResult resStrands = measureEngine(perf, [&] { return bothStrandsSearch(dna, *strands); });
+        printResultRow(out, "", dnaClass, resStrands, showPerf);
+        out << "      -> untai +: " << resStrands.forwardMatches << ", untai -: " << resStrands.reverseMatches << '\n';
+    }
+    if (opt.maxEdits >= 0) {
+        // Hanya 5 hit pertama yang ditampilkan; buffer tetap di stack supaya baris
+        // ini tidak bergantung pada keadaan allocator thread yang menjalankannya
+        const size_t SHOWN_HITS = 5;
+        ApproxHit hits[SHOWN_HITS];
+        AnalysisResult resMyers = measureEngine(perf, [&] {
+            return myersSearch(dna, pattern, opt.maxEdits, hits, SHOWN_HITS);
+        });
+        printResultRow(out, "", dnaClass, resMyers, showPerf);
+        size_t shown = min<size_t>(resMyers.matches, SHOWN_HITS);
+        for (size_t h = 0; h < shown; h++) {
+            out << "      -> akhir=" << hits[h].end << " jarak=" << hits[h].distance << '\n';
+        }
+        if ((size_t)resMyers.matches > shown) out << "      -> ... " << resMyers.matches - shown << " posisi lainnya" << '\n';
+    }
+
+    if (rec.softMasked > 0) out << "      -> soft-mask: " << rec.softMasked << " basa huruf kecil (dicari sebagai huruf besar)" << '\n';
+    out << ROW_SEPARATOR << '\n';
+}
+
+// Satu pass eksplisit per thread sebelum loop record (--warmup 0 = tanpa pass):
+// resolusi simbol lazy, malloc pertama dan buffer thread_local engine (D Shift-And,
+// blok Myers; ukurannya hanya bergantung pada pola) dibayar di sini. Teksnya pola
+// itu sendiri, keluarannya dibuang; alokasinya dikembalikan untuk baris terpisah.
+AllocStats warmUpEngines(const CompiledPattern& pattern, const EngineDispatcher& dispatcher,
+                         const StrandScanner* strands, const AnalysisOptions& opt, PackedSeq& packedDna) {
+    ostream discard(nullptr);
+    DnaRecord rec = {pattern.text, -1};
+    MemoryProbe probe;
+    analyzeRecord(discard, 0, rec, pattern, dispatcher, strands, opt, nullptr, packedDna);
+    return probe.stats();
+}
+
+// Reader (thread pemanggil) -> N worker pencarian -> writer yang menyusun ulang
+// blok per record sesuai urutan input, jadi outputnya sama dengan mode serial.
+int analyzeRecordsPipelined(RecordSource& source, int limit, int threads, const CompiledPattern& pattern,
+                            const EngineDispatcher& dispatcher, const StrandScanner* strands,
+                            const AnalysisOptions& opt, OutputBuffer& output) {
+    // storage hanya terisi untuk FASTA/FASTQ; buffer-nya berputar lewat spare
+    struct RecordTask { int no; DnaRecord rec; FastxRecord storage; };
+    struct RecordOutput { int no; string text; };
+
+    BoundedQueue<RecordTask> tasks(threads * 4);
+    BoundedQueue<RecordOutput> results(threads * 4);
+    BoundedQueue<FastxRecord> spare(threads * 8);   // > jumlah record yang bisa sedang diproses
+
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            // Counter perf dan buffer 2-bit bersifat per thread
+            unique_ptr<PerfSession> perf(opt.perf ? new PerfSession() : nullptr);
+            PackedSeq packedDna;
+            if (opt.warmups > 0) warmUpEngines(pattern, dispatcher, strands, opt, packedDna);
+            RecordTask task;
+            while (tasks.pop(task)) {
+                // View dibuat ulang setelah storage dipindah antar thread
+                if (source.isFastx()) task.rec.sequence = task.storage.sequence;
+                ostringstream block;
+                block << fixed << setprecision(4);
+                analyzeRecord(block, task.no, task.rec, pattern, dispatcher, strands, opt, perf.get(), packedDna);
+                results.push({task.no, block.str()});
+                if (source.isFastx()) spare.push(move(task.storage));
+            }
+        });
+    }
+
+    thread writer([&] {
+        map<int, string> pending;
+        int nextNo = 1;
+        RecordOutput r;
+        while (results.pop(r)) {
+            pending.emplace(r.no, move(r.text));
+            for (auto it = pending.find(nextNo); it != pending.end(); it = pending.find(++nextNo)) {
+                output.append(it->second);
+                pending.erase(it);
+            }
+        }
+    });
+
+    int processedCount = 0;
+    DnaRecord rec;
+    FastxRecord storage;
+    while (processedCount < limit) {
+        spare.tryPop(storage);
+        if (!source.next(rec, storage)) break;
+        processedCount++;
+        tasks.push({processedCount, rec, move(storage)});
+    }
+    tasks.close();
+    for (auto& w : workers) w.join();
+    results.close();
+    writer.join();
+    return processedCount;
+}
+
+void runAnalysis(int limit, const AnalysisOptions& opt) {
+    RecordSource source;
+    if (!source.open(opt.inputFile)) {
+        cout << "Error: File " << opt.inputFile << " tidak ditemukan!" << endl;
+        return;
+    }
+
+    DnaRecord rec;
+    FastxRecord storage;
+    int processedCount = 0;
+    PackedSeq packedDna;
+
+    // Semua tabel pola dibangun sekali di sini, bukan di setiap record
+    CompiledPattern pattern = compilePattern(GENE_PROBE);
+
+    DispatchConfig dispatchConfig;
+    dispatchConfig.load(opt.dispatchFile);
+    EngineDispatcher dispatcher(dispatchConfig);
+
+    unique_ptr<StrandScanner> strands;
+    if (opt.bothStrands) {
+        if (StrandScanner::supports(GENE_PROBE)) strands.reset(new StrandScanner(GENE_PROBE));
+        else cout << "Peringatan: pola berisi basa non-ACGT, mode --both-strands dimatikan." << endl;
+    }
+
+    unique_ptr<PerfSession> perfSession;
+    if (opt.perf) {
+        perfSession.reset(new PerfSession());
+        if (!perfSession->available()) {
+            cout << "Catatan: perf_event_open tidak diizinkan di sistem ini (cek /proc/sys/kernel/perf_event_paranoid);"
+                 << " kolom counter diisi n/a." << endl;
+        }
+    }
+    PerfSession* perf = perfSession.get();
+    bool showPerf = opt.perf;
+
+    cout << fixed << setprecision(4);
+    cout << "\nANALISIS DETAIL MEMORI (Satuan: Byte)" << endl;
+    cout << "==========================================================================================================================================================" << endl;
+    
+    cout << left << setw(4) << "No" 
+         << setw(7) << "Class" 
+         << setw(10) << "Algo" 
+         << setw(12) << "Comp." 
+         << setw(10) << "Time(ms)" 
+         << setw(8) << "Match" 
+         << "| "
+         << setw(10) << "InputMem" 
+         << setw(10) << "LPS Mem" 
+         << setw(10) << "StackMem" 
+         << setw(10) << "HeapPeak" 
+         << setw(8) << "Allocs" 
+         << setw(12) << "TOTAL MEM";
+    if (showPerf) {
+        cout << "| "
+             << setw(12) << "Cycles" 
+             << setw(12) << "Instr" 
+             << setw(7) << "IPC" 
+             << setw(9) << "BrMiss" 
+             << setw(9) << "L1Miss" 
+             << setw(9) << "LLCMiss";
+    }
+    cout << endl;
+         
+    cout << ROW_SEPARATOR << endl;
+    cout << "Preprocessing pola (sekali): " << pattern.buildTime << " ms, Comp. " << pattern.comparisons
+         << " | LPS " << pattern.lpsMemory() << " B, DFA " << pattern.dfaMemory()
+         << " B, Mask " << pattern.forwardMasks.memory() + pattern.reverseMasks.memory()
+         << " B, Packed " << getPackedMemory(pattern.packed) << " B, TOTAL " << pattern.memory() << " B" << endl;
+    cout << "Dispatcher: " << engineName(dispatcher.choose(pattern)) << " (m " << pattern.profile.length
+         << ", periode " << pattern.profile.period << ", run periodik " << pattern.profile.periodicRun << ", skew " << setprecision(2) << pattern.profile.skew << setprecision(4)
+         << ", " << (dispatchConfig.calibrated ? "kalibrasi " + opt.dispatchFile : string("default, belum dikalibrasi")) << ")" << endl;
+    if (strands) {
+        cout << "Dua untai: automaton pola + reverse complement " << strands->memory() << " B"
+             << (strands->isPalindromic() ? ", pola palindrom (hit dihitung di kedua untai)" : "") << endl;
+    }
+    if (opt.warmups > 0) {
+        // Thread pemanggil selalu melakukan pass ini; worker pipeline mengulanginya untuk dirinya sendiri
+        AllocStats warm = warmUpEngines(pattern, dispatcher, strands.get(), opt, packedDna);
+        cout << "Warm-up (1 pass per thread, di luar baris record): " << warm.count << " alokasi, "
+             << warm.allocated << " B dialokasikan, puncak " << warm.peakLive << " B, tertahan " << warm.retained
+             << " B (buffer thread_local engine); --warmup 0 = biaya panggilan pertama masuk ke record pertama" << endl;
+    }
+    cout << ROW_SEPARATOR << endl;
+
+    int threads = opt.threads > 0 ? opt.threads : (int)max(1u, thread::hardware_concurrency());
+    OutputBuffer output(cout);
+    if (threads > 1) {
+        processedCount = analyzeRecordsPipelined(source, limit, threads, pattern, dispatcher, strands.get(), opt, output);
+    } else {
+        ostringstream block;
+        block << fixed << setprecision(4);
+        while (processedCount < limit && source.next(rec, storage)) {
+            processedCount++;
+            block.str("");
+            analyzeRecord(block, processedCount, rec, pattern, dispatcher, strands.get(), opt, perf, packedDna);
+            output.append(block.str());
+        }
+    }
+    output.flush();
+
+    if (processedCount == 0) cout << "File kosong atau format salah." << endl;
+    else cout << source.describe() << ", RSS saat ini: " << getCurrentRSS() << " KB" << endl;
+}
+
+void runMultiPatternAnalysis(int limit, const AnalysisOptions& opt) {
+    vector<string> patterns;
+    if (!loadPatterns(opt.patternsFile, patterns)) {
+        cout << "Error: File pola " << opt.patternsFile << " tidak ditemukan!" << endl;
+        return;
+    }
+    if (patterns.empty()) {
+        cout << "File pola tidak berisi pola ACGT yang valid." << endl;
+        return;
+    }
+
+    RecordSource source;
+    if (!source.open(opt.inputFile)) {
+        cout << "Error: File " << opt.inputFile << " tidak ditemukan!" << endl;
+        return;
+    }
+
+    auto buildStart = chrono::high_resolution_clock::now();
+    AhoCorasick automaton(patterns);
+    auto buildEnd = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> buildTime = buildEnd - buildStart;
+
+    // Probe sama panjang (k-mer) juga dijalankan dengan Rabin-Karp batch sebagai pembanding
+    unique_ptr<RabinKarpSet> rabinKarp;
+    chrono::duration<double, milli> rkBuildTime{0};
+    if (RabinKarpSet::supports(patterns)) {
+        buildStart = chrono::high_resolution_clock::now();
+        rabinKarp.reset(new RabinKarpSet(patterns));
+        buildEnd = chrono::high_resolution_clock::now();
+        rkBuildTime = buildEnd - buildStart;
+    }
+
+    cout << fixed << setprecision(4);
+    cout << "\nANALISIS MULTI-PATTERN (Aho-Corasick)" << endl;
+    cout << "Pola: " << automaton.size() << ", State: " << automaton.stateCount()
+         << ", Tabel: " << automaton.tableMemory() << " Byte, Build: " << buildTime.count() << " ms" << endl;
+    if (rabinKarp) {
+        cout << "Rabin-Karp (k=" << rabinKarp->length() << (rabinKarp->isExact() ? ", kunci 2-bit eksak" : ", hash + verifikasi")
+             << "): " << rabinKarp->keyCount() << " kunci di " << rabinKarp->slotCount() << " slot, Tabel: "
+             << rabinKarp->tableMemory() << " Byte, Build: " << rkBuildTime.count() << " ms" << endl;
+    }
+    cout << "==========================================================================" << endl;
+    cout << left << setw(6) << "No" 
+         << setw(7) << "Class" 
+         << setw(12) << "Length" 
+         << setw(12) << "Comp." 
+         << setw(10) << "Time(ms)" 
+         << setw(10) << "Hits" 
+         << setw(10) << "PolaKena";
+    if (rabinKarp) cout << setw(10) << "RK(ms)" << "Cek";
+    cout << endl;
+    cout << "--------------------------------------------------------------------------" << endl;
+
+    vector<long long> totalCounts(patterns.size(), 0);
+    vector<long long> recordCounts(patterns.size(), 0);
+    vector<long long> rkCounts(patterns.size(), 0);
+    DnaRecord rec;
+    FastxRecord storage;
+    int processedCount = 0;
+    double totalTime = 0, rkTotalTime = 0;
+    int rkMismatches = 0;
+
+    while (processedCount < limit && source.next(rec, storage)) {
+        processedCount++;
+        fill(recordCounts.begin(), recordCounts.end(), 0);
+        long long comparisons = 0;
+
+        auto start = chrono::high_resolution_clock::now();
+        automaton.scan(rec.sequence, recordCounts, comparisons);
+        auto end = chrono::high_resolution_clock::now();
+        chrono::duration<double, milli> elapsed = end - start;
+        totalTime += elapsed.count();
+
+        long long hits = 0;
+        int patternsHit = 0;
+        for (size_t id = 0; id < patterns.size(); id++) {
+            hits += recordCounts[id];
+            if (recordCounts[id] > 0) patternsHit++;
+            totalCounts[id] += recordCounts[id];
+        }
+
+        cout << left << setw(6) << processedCount 
+             << setw(7) << (rec.dnaClass < 0 ? string("-") : to_string(rec.dnaClass))
+             << setw(12) << rec.sequence.size() 
+             << setw(12) << comparisons 
+             << setw(10) << elapsed.count() 
+             << setw(10) << hits 
+             << setw(10) << patternsHit;
+        if (rabinKarp) {
+            fill(rkCounts.begin(), rkCounts.end(), 0);
+            long long rkComparisons = 0;
+            start = chrono::high_resolution_clock::now();
+            rabinKarp->scan(rec.sequence, rkCounts, rkComparisons);
+            end = chrono::high_resolution_clock::now();
+            elapsed = end - start;
+            rkTotalTime += elapsed.count();
+            bool same = rkCounts == recordCounts;
+            if (!same) rkMismatches++;
+            cout << setw(10) << elapsed.count() << (same ? "OK" : "BEDA");
+        }
+        cout << endl;
+    }
+
+    if (processedCount == 0) {
+        cout << "File kosong atau format salah." << endl;
+        return;
+    }
+
+    cout << "--------------------------------------------------------------------------" << endl;
+    cout << "Total waktu scan: " << totalTime << " ms untuk " << processedCount << " sekuens (satu pass per sekuens)" << endl;
+    if (rabinKarp) {
+        cout << "Total Rabin-Karp: " << rkTotalTime << " ms, " << (rkMismatches == 0 ? string("semua hitungan sama dengan Aho-Corasick")
+             : to_string(rkMismatches) + " sekuens BEDA dengan Aho-Corasick") << endl;
+    }
+    cout << "\nJumlah match per pola:" << endl;
+    cout << left << setw(8) << "ID" << setw(10) << "Panjang" << setw(12) << "Match" << "Awalan" << endl;
+    for (size_t id = 0; id < patterns.size(); id++) {
+        cout << left << setw(8) << id + 1 
+             << setw(10) << patterns[id].length() 
+             << setw(12) << totalCounts[id] 
+             << patterns[id].substr(0, 24) << (patterns[id].length() > 24 ? "..." : "") << endl;
+    }
+}
+
+// Pola dari --patterns dijalankan atas semua record --input: loop bersarang
+// kmpSearch sebagai baseline, lalu scheduler tiled dengan engine yang sama,
+// jadi selisihnya murni dari urutan akses memori. KMP terikat komputasi
+// (~1 basa per beberapa ns), jadi pasangan yang sama juga diukur dengan SIMD,
+// engine yang cukup cepat untuk dibatasi bandwidth memori. Dengan --threads N
+// kedua jadwal juga dijalankan dengan N thread (nested membagi pola, tiled membagi tile).
+void runTiledBatch(int limit, const AnalysisOptions& opt) {
+    vector<string> patternTexts;
+    if (opt.patternsFile.empty() || !loadPatterns(opt.patternsFile, patternTexts)) {
+        cout << "Error: mode --tiled butuh file pola (--patterns FILE)." << endl;
+        return;
+    }
+    if (patternTexts.empty()) {
+        cout << "File pola tidak berisi pola ACGT yang valid." << endl;
+        return;
+    }
+    RecordSource source;
+    if (!source.open(opt.inputFile)) {
+        cout << "Error: File " << opt.inputFile << " tidak ditemukan!" << endl;
+        return;
+    }
+
+    // Record mmap dirujuk langsung; FASTA/FASTQ disalin ke deque (alamat tetap stabil)
+    vector<string_view> records;
+    deque<string> owned;
+    size_t corpusBytes = 0;
+    DnaRecord rec;
+    FastxRecord storage;
+    while ((int)records.size() < limit && source.next(rec, storage)) {
+        if (source.isFastx()) {
+            owned.push_back(move(storage.sequence));
+            rec.sequence = owned.back();
+        }
+        records.push_back(rec.sequence);
+        corpusBytes += rec.sequence.size();
+    }
+    if (records.empty()) {
+        cout << "File kosong atau format salah." << endl;
+        return;
+    }
+
+    vector<CompiledPattern> patterns;
+    patterns.reserve(patternTexts.size());
+    size_t tableBytes = 0;     // yang dibaca kmpSearch per pola: teks pola + LPS
+    for (const string& p : patternTexts) {
+        patterns.push_back(compilePattern(p));
+        tableBytes += p.size() + patterns.back().lpsMemory();
+    }
+
+    size_t l2 = l2CacheBytes();
+    // Setengah L2 untuk tile, sisanya untuk tabel pola yang sedang dipakai
+    size_t tileBytes = opt.tileBytes > 0 ? opt.tileBytes : l2 / 2;
+    vector<RecordTile> tiles = buildRecordTiles(records, tileBytes);
+    int threads = opt.threads > 0 ? opt.threads : (int)max(1u, thread::hardware_concurrency());
+
+    auto kmp = [](string_view text, const CompiledPattern& cp) { return kmpSearch(text, cp); };
+    auto simd = [](string_view text, const CompiledPattern& cp) { return simdSearch(text, cp); };
+    PerfSession perf;
+
+    struct TiledRun { string name; double ms; long long llcMisses; uint64_t modelBytes; bool same; };
+    vector<TiledRun> runs;
+    CountMatrix reference, matrix;
+    reference.reset(patterns.size(), records.size());
+
+    auto timed = [&](auto&& body, long long& llcMisses) {
+        perf.start();
+        auto start = chrono::high_resolution_clock::now();
+        body();
+        auto end = chrono::high_resolution_clock::now();
+        llcMisses = perf.stop().llcMisses;
+        chrono::duration<double, milli> elapsed = end - start;
+        return elapsed.count();
+    };
+
+    // Model trafik DRAM: nested membaca korpus sekali per pola, tabel pola tetap
+    // panas selama satu pola; tiled membaca korpus sekali, tabel sekali per tile
+    uint64_t nestedBytes = (uint64_t)patterns.size() * corpusBytes + tableBytes;
+    uint64_t tiledBytes = corpusBytes + (uint64_t)tiles.size() * tableBytes;
+
+    // Nested dan tiled selalu berpasangan dengan jumlah thread yang sama, jadi rasio
+    // tiled/nested hanya mengukur efek tiling, bukan efek paralelisme
+    struct TiledPair { string label; size_t nested; size_t tiled; };
+    vector<TiledPair> pairs;
+    auto runPair = [&](const string& engine, int threadCount, auto&& search) {
+        string suffix = threadCount > 1 ? " " + to_string(threadCount) + "T" : "";
+        // Counter perf hanya melihat thread pemanggil, jadi tidak diisi untuk mode paralel
+        long long llc = -1;
+        matrix.reset(patterns.size(), records.size());
+        double ms = timed([&] { countNested(records, patterns, matrix, threadCount, search); }, llc);
+        runs.push_back({engine + " nested" + suffix, ms, threadCount > 1 ? -1 : llc, nestedBytes,
+                        runs.empty() || matrix.counts == reference.counts});
+        if (runs.size() == 1) reference = matrix;
+        matrix.reset(patterns.size(), records.size());
+        ms = timed([&] { countTiled(records, tiles, patterns, matrix, threadCount, search); }, llc);
+        runs.push_back({engine + " tiled" + suffix, ms, threadCount > 1 ? -1 : llc, tiledBytes,
+                        matrix.counts == reference.counts});
+        pairs.push_back({engine + (threadCount > 1 ? suffix : " 1T"), runs.size() - 2, runs.size() - 1});
+    };
+    runPair("KMP", 1, kmp);
+    if (threads > 1) runPair("KMP", threads, kmp);
+    runPair("SIMD", 1, simd);
+    if (threads > 1) runPair("SIMD", threads, simd);
+
+    cout << fixed << setprecision(4);
+    cout << "\nBATCH TILED POLA x RECORD" << endl;
+    cout << "Pola: " << patterns.size() << " (tabel " << tableBytes << " Byte), Record: " << records.size()
+         << " (" << corpusBytes << " Byte), Tile: " << tileBytes << " Byte x " << tiles.size()
+         << " (L2 " << l2 << " Byte), Thread: " << threads << endl;
+    cout << "==========================================================================" << endl;
+    cout << left << setw(16) << "Mode" 
+         << setw(12) << "Time(ms)" 
+         << setw(10) << "GB/s" 
+         << setw(12) << "LLCMiss" 
+         << setw(16) << "Estimasi(B)" 
+         << "Cek" << endl;
+    cout << "--------------------------------------------------------------------------" << endl;
+    uint64_t scannedBytes = (uint64_t)patterns.size() * corpusBytes;
+    for (const TiledRun& run : runs) {
+        double gbps = run.ms > 0 ? (scannedBytes / 1e9) / (run.ms / 1000.0) : 0;
+        cout << left << setw(16) << run.name 
+             << setw(12) << run.ms 
+             << setw(10) << gbps 
+             << setw(12) << perfValue(run.llcMisses) 
+             << setw(16) << run.modelBytes 
+             << (run.same ? "OK" : "BEDA") << endl;
+    }
+    cout << "--------------------------------------------------------------------------" << endl;
+
+    // Estimasi model dan hasil ukur (LLC miss x 64 B) ditampilkan berdampingan
+    // supaya klaim penghematan bisa dicek terhadap counter, bukan hanya model
+    double saved = nestedBytes > 0 ? 100.0 * (1.0 - (double)tiledBytes / nestedBytes) : 0;
+    cout << "Trafik DRAM (estimasi model): nested " << nestedBytes << " Byte, tiled " << tiledBytes << " Byte, selisih "
+         << (long long)nestedBytes - (long long)tiledBytes << " Byte, hemat " << setprecision(1) << saved << "%" << setprecision(4) << endl;
+    auto measuredDelta = [&](const string& engine, const TiledRun& nested, const TiledRun& tiled) {
+        cout << "Trafik DRAM " << left << setw(4) << engine << " (ukur, LLC miss x 64 B): ";
+        if (nested.llcMisses < 0 || tiled.llcMisses < 0) {
+            cout << "tidak tersedia (counter LLC perf_event_open ditolak/tidak didukung)" << endl;
+            return;
+        }
+        long long nestedMeasured = nested.llcMisses * 64;
+        long long tiledMeasured = tiled.llcMisses * 64;
+        cout << "nested " << nestedMeasured << " Byte, tiled " << tiledMeasured << " Byte, selisih "
+             << nestedMeasured - tiledMeasured << " Byte";
+        if (nestedMeasured > 0) {
+            cout << ", hemat " << setprecision(1) << 100.0 * (1.0 - (double)tiledMeasured / nestedMeasured) << "%" << setprecision(4);
+        }
+        cout << endl;
+    };
+    for (const TiledPair& pair : pairs) {
+        if (pair.label.find(" 1T") == string::npos) continue;
+        measuredDelta(pair.label.substr(0, pair.label.find(' ')), runs[pair.nested], runs[pair.tiled]);
+    }
+    cout << "Tiled vs nested (thread sama):";
+    for (const TiledPair& pair : pairs) {
+        double speedup = runs[pair.tiled].ms > 0 ? runs[pair.nested].ms / runs[pair.tiled].ms : 0;
+        cout << " " << pair.label << " " << setprecision(2) << speedup << "x" << setprecision(4)
+             << (&pair != &pairs.back() ? "," : "");
+    }
+    cout << endl;
+    if (corpusBytes <= l2) cout << "Catatan: korpus muat di L2, jadi nested juga tidak membaca ulang dari DRAM." << endl;
+    cout << "Matriks hitungan: " << reference.patterns << " x " << reference.records << " uint32 = " << reference.memory() << " Byte" << endl;
+
+    if (!opt.matrixFile.empty()) {
+        ofstream out(opt.matrixFile);
+        out << "pola";
+        for (size_t r = 0; r < reference.records; r++) out << '\t' << r + 1;
+        out << '\n';
+        for (size_t p = 0; p < reference.patterns; p++) {
+            out << p + 1;
+            for (size_t r = 0; r < reference.records; r++) out << '\t' << reference.at(p, r);
+            out << '\n';
+        }
+        if (out) cout << "Matriks ditulis ke " << opt.matrixFile << endl;
+        else cout << "Error: tidak bisa menulis " << opt.matrixFile << endl;
+    }
+}
+
+// Satu pass streaming atas seluruh --input: reader -> worker yang menghitung
+// k-mer ke tabel kelas masing-masing. Tidak ada prompt jumlah sekuens.
+void runKmerSpectrum(const AnalysisOptions& opt) {
+    RecordSource source;
+    if (!source.open(opt.inputFile)) {
+        cout << "Error: File " << opt.inputFile << " tidak ditemukan!" << endl;
+        return;
+    }
+    int k = opt.kmerLength;
+    int threads = opt.threads > 0 ? opt.threads : (int)max(1u, thread::hardware_concurrency());
+
+    // Tabel per kelas dibuat saat kelas itu pertama kali terlihat
+    map<int, unique_ptr<ShardedKmerCounter>> classes;
+    mutex classLock;
+    auto counterFor = [&](int dnaClass) -> ShardedKmerCounter& {
+        lock_guard<mutex> lock(classLock);
+        unique_ptr<ShardedKmerCounter>& counter = classes[dnaClass];
+        if (!counter) counter.reset(new ShardedKmerCounter());
+        return *counter;
+    };
+
+    auto start = chrono::high_resolution_clock::now();
+    uint64_t recordCount = 0;
+    DnaRecord rec;
+    FastxRecord storage;
+    if (threads <= 1) {
+        unique_ptr<KmerBatch> batch(new KmerBatch());
+        while (source.next(rec, storage)) {
+            recordCount++;
+            countRecordKmers(rec.sequence, k, counterFor(rec.dnaClass), *batch);
+        }
+    } else {
+        struct RecordTask { DnaRecord rec; FastxRecord storage; };
+        BoundedQueue<RecordTask> tasks(threads * 4);
+        BoundedQueue<FastxRecord> spare(threads * 8);
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                unique_ptr<KmerBatch> batch(new KmerBatch());
+                RecordTask task;
+                while (tasks.pop(task)) {
+                    if (source.isFastx()) task.rec.sequence = task.storage.sequence;
+                    countRecordKmers(task.rec.sequence, k, counterFor(task.rec.dnaClass), *batch);
+                    if (source.isFastx()) spare.push(move(task.storage));
+                }
+            });
+        }
+        while (true) {
+            spare.tryPop(storage);
+            if (!source.next(rec, storage)) break;
+            recordCount++;
+            tasks.push({rec, move(storage)});
+        }
+        tasks.close();
+        for (auto& w : workers) w.join();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+
+    if (recordCount == 0) {
+        cout << "File kosong atau format salah." << endl;
+        return;
+    }
+
+    cout << fixed << setprecision(4);
+    cout << "\nSPEKTRUM K-MER PER KELAS (k=" << k << ", thread " << threads << ")" << endl;
+    cout << "==========================================================================" << endl;
+    cout << left << setw(7) << "Class" 
+         << setw(10) << "Record" 
+         << setw(14) << "Basa" 
+         << setw(14) << "K-mer" 
+         << setw(12) << "Distinct" 
+         << setw(14) << "Tabel(B)" << endl;
+    cout << "--------------------------------------------------------------------------" << endl;
+
+    ofstream out;
+    if (!opt.spectrumFile.empty()) {
+        out.open(opt.spectrumFile, ios::binary);
+        KmerSpectrumHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, KMER_MAGIC, sizeof(KMER_MAGIC));
+        header.k = (uint32_t)k;
+        header.classCount = (uint32_t)classes.size();
+        out.write((const char*)&header, sizeof(header));
+    }
+
+    uint64_t totalBases = 0;
+    vector<pair<uint64_t, uint64_t>> spectrum;    // (k-mer, count), dipakai ulang antar kelas
+    string encoded;
+    stringstream topLines;
+    for (const auto& entry : classes) {
+        const ShardedKmerCounter& counter = *entry.second;
+        spectrum.clear();
+        spectrum.reserve(counter.distinct());
+        counter.forEach([&](uint64_t kmer, uint64_t count) { spectrum.push_back({kmer, count}); });
+        sort(spectrum.begin(), spectrum.end());
+        totalBases += counter.bases;
+
+        // Top-N: count turun, seri dipecah dengan k-mer naik supaya hasil deterministik
+        size_t topCount = min<size_t>(opt.topKmers, spectrum.size());
+        vector<pair<uint64_t, uint64_t>> best(topCount);
+        partial_sort_copy(spectrum.begin(), spectrum.end(), best.begin(), best.end(),
+                          [](const pair<uint64_t, uint64_t>& a, const pair<uint64_t, uint64_t>& b) {
+                              return a.second != b.second ? a.second > b.second : a.first < b.first;
+                          });
+        vector<KmerTopEntry> top;
+        for (const auto& b : best) top.push_back({b.first, b.second});
+
+        cout << left << setw(7) << (entry.first < 0 ? string("-") : to_string(entry.first)) 
+             << setw(10) << counter.records 
+             << setw(14) << counter.bases 
+             << setw(14) << counter.kmers 
+             << setw(12) << spectrum.size() 
+             << setw(14) << counter.memory() << endl;
+        topLines << "Class " << (entry.first < 0 ? string("-") : to_string(entry.first)) << ":";
+        for (const KmerTopEntry& t : top) topLines << ' ' << kmerToString(t.kmer, k) << '=' << t.count;
+        topLines << '\n';
+
+        if (out.is_open()) {
+            encoded.clear();
+            uint64_t previous = 0;
+            for (const auto& s : spectrum) {
+                appendVarint(encoded, s.first - previous);
+                appendVarint(encoded, s.second);
+                previous = s.first;
+            }
+            KmerClassHeader classHeader;
+            memset(&classHeader, 0, sizeof(classHeader));
+            classHeader.dnaClass = entry.first;
+            classHeader.topCount = (uint32_t)topCount;
+            classHeader.records = counter.records;
+            classHeader.bases = counter.bases;
+            classHeader.kmers = counter.kmers;
+            classHeader.distinct = spectrum.size();
+            classHeader.spectrumBytes = encoded.size();
+            out.write((const char*)&classHeader, sizeof(classHeader));
+            out.write((const char*)top.data(), top.size() * sizeof(KmerTopEntry));
+            out.write(encoded.data(), encoded.size());
+        }
+    }
+    cout << "--------------------------------------------------------------------------" << endl;
+    cout << "Top " << opt.topKmers << " k-mer per kelas:" << endl << topLines.str();
+    cout << "--------------------------------------------------------------------------" << endl;
+    double seconds = elapsed.count() / 1000.0;
+    cout << "Waktu hitung: " << elapsed.count() << " ms untuk " << recordCount << " record (" 
+         << (seconds > 0 ? totalBases / 1e6 / seconds : 0) << " MB/s), " << source.describe()
+         << ", RSS saat ini: " << getCurrentRSS() << " KB" << endl;
+    if (out.is_open()) {
+        if (out.good()) cout << "Spektrum ditulis ke " << opt.spectrumFile << " (" << out.tellp() << " Byte)" << endl;
+        else cout << "Error: gagal menulis " << opt.spectrumFile << endl;
+    } else if (!opt.spectrumFile.empty()) {
+        cout << "Error: tidak bisa membuka " << opt.spectrumFile << endl;
+    }
+}
+
+void runIndexBuild(const string& indexPath, const string& inputFile) {
+    RecordSource source;
+    if (!source.open(inputFile)) {
+        cout << "Error: File " << inputFile << " tidak ditemukan!" << endl;
+        return;
+    }
+
+    uint64_t recordCount = 0;
+    auto start = chrono::high_resolution_clock::now();
+    bool ok = buildFmIndex(source, indexPath, recordCount);
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+    if (!ok) {
+        cout << "Error: gagal menulis index " << indexPath << endl;
+        return;
+    }
+
+    FmIndex index;
+    index.load(indexPath);
+    cout << fixed << setprecision(4);
+    cout << "\nFM-INDEX BUILD" << endl;
+    cout << "  - Record       : " << recordCount << endl;
+    cout << "  - Teks         : " << index.length() << " simbol (termasuk pemisah)" << endl;
+    cout << "  - Build Time   : " << elapsed.count() << " ms" << endl;
+    cout << "  - Index Size   : " << index.sizeInBytes() << " Byte ("
+         << (double)index.sizeInBytes() / max<uint64_t>(1, index.length()) << " Byte/basa)" << endl;
+    cout << "  - Peak RSS     : " << getPeakRSS() << " KB" << endl;
+}
+
+// inputFile harus sumber yang sama dengan saat index dibangun; ia dipindai ulang
+// dengan KMP untuk setiap query sebagai pembanding, jadi stdin tidak bisa dipakai
+void runIndexQuery(const string& indexPath, const string& inputFile) {
+    FmIndex index;
+    if (!index.load(indexPath)) {
+        cout << "Error: index " << indexPath << " tidak ditemukan atau rusak!" << endl;
+        return;
+    }
+    if (inputFile == "-") {
+        cout << "Error: --query-index memindai ulang --input per query; stdin (-) tidak didukung." << endl;
+        return;
+    }
+    RecordSource check;
+    if (!check.open(inputFile)) {
+        cout << "Error: File " << inputFile << " tidak ditemukan!" << endl;
+        return;
+    }
+
+    // Probe gen penuh + beberapa awalannya (awalan pendek = lebih banyak hit)
+    vector<string> queries;
+    for (size_t len : {12, 32, 100, 400}) queries.push_back(GENE_PROBE.substr(0, len));
+    queries.push_back(GENE_PROBE);
+
+    const int REPEAT = 1000;
+    cout << fixed << setprecision(4);
+    cout << "\nFM-INDEX QUERY vs KMP SCAN (index " << index.sizeInBytes() << " Byte, mmap)" << endl;
+    cout << "================================================================================" << endl;
+    cout << left << setw(8) << "Len" 
+         << setw(10) << "Count" 
+         << setw(14) << "Count(us)" 
+         << setw(14) << "Locate(us)" 
+         << setw(14) << "KMP Scan(ms)" 
+         << setw(10) << "Status" << endl;
+    cout << "--------------------------------------------------------------------------------" << endl;
+
+    for (const string& q : queries) {
+        uint64_t hits = 0;
+        auto countStart = chrono::high_resolution_clock::now();
+        for (int r = 0; r < REPEAT; r++) hits = index.count(q);
+        auto countEnd = chrono::high_resolution_clock::now();
+        chrono::duration<double, micro> countTime = countEnd - countStart;
+
+        vector<FmLocation> locations;
+        auto locateStart = chrono::high_resolution_clock::now();
+        index.locate(q, locations);
+        auto locateEnd = chrono::high_resolution_clock::now();
+        chrono::duration<double, micro> locateTime = locateEnd - locateStart;
+
+        // Pembanding: scan linear seluruh korpus dengan kmpSearch. Posisi KMP ditampung
+        // di buffer seukuran hasil index (+1 untuk mendeteksi kelebihan hit)
+        vector<uint64_t> offsets(hits + 1);
+        vector<FmLocation> expected;
+        expected.reserve(hits + 1);
+        RecordSource scan;
+        scan.open(inputFile);
+        DnaRecord rec;
+        FastxRecord storage;
+        long long kmpHits = 0;
+        bool overflow = false;
+        uint64_t record = 0;
+        auto scanStart = chrono::high_resolution_clock::now();
+        CompiledPattern compiled = compilePattern(q);
+        while (scan.next(rec, storage)) {
+            SpanSink sink(offsets.data(), offsets.size());
+            kmpHits += kmpSearch(rec.sequence, compiled, &sink).matches;
+            overflow = overflow || sink.overflow() || expected.size() + sink.size() > hits;
+            for (size_t h = 0; h < sink.size() && expected.size() <= hits; h++) expected.push_back({record, sink.data()[h]});
+            record++;
+        }
+        auto scanEnd = chrono::high_resolution_clock::now();
+        chrono::duration<double, milli> scanTime = scanEnd - scanStart;
+
+        // Bandingkan pasangan (record, offset), bukan hanya jumlahnya: sampel SA atau
+        // LF-walk yang salah tetap menghasilkan jumlah lokasi yang benar
+        auto byPosition = [](const FmLocation& a, const FmLocation& b) {
+            return a.record != b.record ? a.record < b.record : a.offset < b.offset;
+        };
+        sort(locations.begin(), locations.end(), byPosition);
+        bool same = !overflow && (long long)hits == kmpHits && locations.size() == expected.size()
+                    && equal(locations.begin(), locations.end(), expected.begin(),
+                             [](const FmLocation& a, const FmLocation& b) { return a.record == b.record && a.offset == b.offset; });
+
+        cout << left << setw(8) << q.length() 
+             << setw(10) << hits 
+             << setw(14) << countTime.count() / REPEAT 
+             << setw(14) << locateTime.count() 
+             << setw(14) << scanTime.count() 
+             << setw(10) << (same ? "OK" : "MISMATCH") << endl;
+    }
+    cout << "--------------------------------------------------------------------------------" << endl;
+    cout << "Count(us) dirata-rata dari " << REPEAT << " query; Locate termasuk pemetaan ke (record, offset)." << endl;
+    cout << "Status OK = jumlah dan setiap pasangan (record, offset) dari locate sama dengan posisi scan KMP." << endl;
+}
+
+// Pemindaian streaming: file dibaca per potongan ke satu buffer yang dipakai
+// ulang, jadi memori tetap (buffer + LPS) berapa pun ukuran input.
+void runStreamSearch(const AnalysisOptions& opt) {
+    int fd = (opt.streamFile == "-") ? STDIN_FILENO : open(opt.streamFile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cout << "Error: File " << opt.streamFile << " tidak ditemukan!" << endl;
+        return;
+    }
+
+    CompiledPattern pattern = compilePattern(GENE_PROBE);
+    StreamingKmp matcher(pattern);
+    vector<char> buffer(max<size_t>(1, opt.chunkSize));
+    // Stream bisa berisi match tanpa batas: simpan 5 posisi pertama dan 5 terakhir saja
+    const size_t SHOWN_HITS = 5;
+    uint64_t firstBuffer[SHOWN_HITS];
+    SpanSink firstHits(firstBuffer, SHOWN_HITS);
+    RingBufferSink<SHOWN_HITS> lastHits;
+    uint64_t chunks = 0;
+
+    auto start = chrono::high_resolution_clock::now();
+    while (true) {
+        ssize_t got = read(fd, buffer.data(), buffer.size());
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        chunks++;
+        matcher.feed(string_view(buffer.data(), (size_t)got), [&](uint64_t pos) {
+            firstHits.report(pos);
+            lastHits.report(pos);
+        });
+    }
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+    if (fd != STDIN_FILENO) close(fd);
+
+    double seconds = elapsed.count() / 1000.0;
+    cout << fixed << setprecision(4);
+    cout << "\nKMP STREAMING (" << (opt.streamFile == "-" ? string("stdin") : opt.streamFile) << ")" << endl;
+    cout << "==========================================================================" << endl;
+    cout << "Byte diproses : " << matcher.position() << " dalam " << chunks << " potongan @ " << buffer.size() << " Byte" << endl;
+    cout << "Match         : " << matcher.matches() << endl;
+    for (size_t h = 0; h < firstHits.size(); h++) cout << "  -> posisi " << firstHits.data()[h] << endl;
+    // Posisi terakhir yang belum tercetak di daftar pertama
+    uint64_t hidden = matcher.matches() - firstHits.size();
+    size_t tail = (size_t)min<uint64_t>(hidden, lastHits.size());
+    if (hidden > tail) cout << "  -> ... " << hidden - tail << " posisi lainnya" << endl;
+    for (size_t h = lastHits.size() - tail; h < lastHits.size(); h++) cout << "  -> posisi " << lastHits[h] << endl;
+    cout << "Waktu         : " << elapsed.count() << " ms (" << (seconds > 0 ? matcher.position() / 1e6 / seconds : 0) << " MB/s)" << endl;
+    cout << "Memori        : buffer " << buffer.capacity() << " B + LPS " << pattern.lpsMemory() << " B, RSS saat ini "
+         << getCurrentRSS() << " KB" << endl;
+}
+
+// Kalibrasi dispatcher: titik potong SIMD/BNDM dan engine terbaik untuk pola
+// periodik dan pola dengan skew tinggi diukur di mesin ini, lalu disimpan.
+// "4096", "64K", "512M", "8G" (kelipatan 1024) -> byte; 0 jika tidak valid
+uint64_t parseByteSize(const string& text) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = strtoull(text.c_str(), &end, 10);
+    if (errno != 0 || end == text.c_str()) return 0;
+    int shift = 0;
+    switch (toupper((unsigned char)*end)) {
+        case '\0': break;
+        case 'K': shift = 10; break;
+        case 'M': shift = 20; break;
+        case 'G': shift = 30; break;
+        case 'T': shift = 40; break;
+        default:  return 0;
+    }
+    if (*end && end[1] != '\0') return 0;
+    if (value > (UINT64_MAX >> shift)) return 0;
+    return (uint64_t)value << shift;
+}
+
+// Info ditulis ke stderr jika teks dikirim ke stdout, supaya pipe tetap berisi basa saja
+void runGenerate(const AnalysisOptions& opt) {
+    const WorkloadSpec& spec = opt.workload;
+    bool toStdout = opt.generateFile == "-";
+    ostream& log = toStdout ? cerr : cout;
+
+    vector<uint64_t> offsets;
+    auto start = chrono::high_resolution_clock::now();
+    bool ok = writeWorkload(spec, opt.generateFile, opt.chunkSize, &offsets);
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> elapsed = end - start;
+    if (!ok) {
+        log << "Error: gagal menulis " << opt.generateFile << endl;
+        return;
+    }
+
+    double seconds = elapsed.count() / 1000.0;
+    log << fixed << setprecision(4);
+    log << "\nGENERATOR WORKLOAD (" << (toStdout ? string("stdout") : opt.generateFile) << ")" << endl;
+    log << "==========================================================================" << endl;
+    log << "Jenis         : " << workloadKindName(spec.kind);
+    if (spec.kind == WorkloadKind::Repeat) log << " (motif " << spec.motif << ", mutasi " << spec.mutationRate << ")";
+    log << ", seed " << spec.seed << endl;
+    log << "Byte ditulis  : " << spec.length << " dalam potongan @ " << opt.chunkSize << " Byte" << endl;
+    log << "Waktu         : " << elapsed.count() << " ms (" << (seconds > 0 ? spec.length / 1e6 / seconds : 0) << " MB/s)" << endl;
+    if (!spec.plant.empty()) {
+        log << "Pola ditanam  : " << offsets.size() << " x " << spec.plant.size() << " bp" << endl;
+        for (size_t k = 0; k < offsets.size() && k < 5; k++) log << "  -> posisi " << offsets[k] << endl;
+        if (offsets.size() > 5) log << "  -> ... " << offsets.size() - 5 << " posisi lainnya" << endl;
+        if (!toStdout) {
+            ofstream list(opt.generateFile + ".offsets");
+            for (uint64_t off : offsets) list << off << '\n';
+            if (list) log << "Daftar offset : " << opt.generateFile << ".offsets" << endl;
+        }
+    }
+}
+
+void runCalibration(const AnalysisOptions& opt) {
+    const size_t TEXT_LENGTH = 4 << 20;
+    const size_t REPEAT_TEXT_LENGTH = 256 << 10;
+    const int REPEATS = 3;
+    mt19937_64 rng(42);
+
+    // Waktu terbaik dari beberapa pengulangan (ms)
+    auto bestTime = [&](EngineKind kind, string_view text, const CompiledPattern& cp) {
+        double best = 0;
+        for (int r = 0; r < REPEATS; r++) {
+            auto start = chrono::steady_clock::now();
+            runEngine(kind, text, cp);
+            auto end = chrono::steady_clock::now();
+            chrono::duration<double, milli> elapsed = end - start;
+            if (r == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        return best;
+    };
+    // Engine kandidat dengan total waktu terkecil atas semua probe (teks, pola);
+    // kandidat pertama jadi pemenang jika waktunya seri
+    auto fastest = [&](const vector<EngineKind>& candidates, const vector<pair<string_view, const CompiledPattern*>>& probes) {
+        EngineKind winner = candidates.front();
+        double winnerTime = 0;
+        for (EngineKind kind : candidates) {
+            double t = 0;
+            cout << "  " << left << setw(10) << engineName(kind);
+            for (const auto& probe : probes) {
+                double probeTime = bestTime(kind, probe.first, *probe.second);
+                cout << setw(14) << probeTime;
+                t += probeTime;
+            }
+            cout << "total " << t << " ms" << endl;
+            if (kind == candidates.front() || t < winnerTime) {
+                winner = kind;
+                winnerTime = t;
+            }
+        }
+        return winner;
+    };
+
+    DispatchConfig config;
+    cout << fixed << setprecision(4);
+    cout << "\nKALIBRASI DISPATCHER" << endl;
+    cout << "==========================================================================" << endl;
+
+    // 1. Titik potong SIMD vs BNDM pada teks acak seragam
+    WorkloadSpec uniform;
+    uniform.length = TEXT_LENGTH;
+    string text;
+    generateWorkload(uniform, text);
+    cout << left << setw(8) << "m" << setw(12) << "SIMD(ms)" << setw(12) << "BNDM(ms)" << endl;
+    vector<pair<size_t, bool>> bndmWins;
+    for (size_t m = 8; m <= 2048; m *= 2) {
+        CompiledPattern cp = compilePattern(string_view(text).substr(rng() % (TEXT_LENGTH - m), m));
+        double simd = bestTime(EngineKind::Simd, text, cp);
+        double bndm = bestTime(EngineKind::Bndm, text, cp);
+        bndmWins.push_back({m, bndm < simd});
+        cout << left << setw(8) << m << setw(12) << simd << setw(12) << bndm << endl;
+    }
+    // Titik potong = m terkecil sehingga BNDM menang di m itu dan semua m di atasnya
+    config.bndmMinLength = SIZE_MAX;
+    for (size_t i = bndmWins.size(); i-- > 0 && bndmWins[i].second;) config.bndmMinLength = bndmWins[i].first;
+
+    // 2. Pola periodik (CAG)^50, (CAG)^1000 dan hampir periodik (CAG)^1000 + T pada
+    //    teks berulang. Hanya engine linear yang boleh menang: ekor T tidak pernah
+    //    muncul di teks, jadi filter byte terakhir SIMD menolak semua posisi dengan
+    //    murah di probe ketiga, padahal (CAG)^1000 tanpa ekor membuatnya O(n*m).
+    WorkloadSpec repeat;
+    repeat.kind = WorkloadKind::Repeat;
+    repeat.length = REPEAT_TEXT_LENGTH;
+    string repeatText;
+    generateWorkload(repeat, repeatText);
+    string shortPeriodicPattern, periodicPattern;
+    for (int i = 0; i < 50; i++) shortPeriodicPattern += "CAG";
+    for (int i = 0; i < 1000; i++) periodicPattern += "CAG";
+    vector<CompiledPattern> periodicProbes;
+    periodicProbes.push_back(compilePattern(shortPeriodicPattern));
+    periodicProbes.push_back(compilePattern(periodicPattern));
+    periodicProbes.push_back(compilePattern(periodicPattern + "T"));
+    cout << "Pola (CAG)^50 | (CAG)^1000 | (CAG)^1000+T, teks CAG berulang " << repeatText.length() << " Byte:" << endl;
+    vector<pair<string_view, const CompiledPattern*>> probes;
+    for (const CompiledPattern& cp : periodicProbes) probes.push_back({repeatText, &cp});
+    config.periodicEngine = fastest({EngineKind::KmpDfa, EngineKind::TwoWay}, probes);
+
+    // 3. Skew tinggi: pola dan teks kaya A (~70%)
+    mt19937_64 skewRng(43);
+    auto skewedWorkload = [&](double share, string& out) {
+        WorkloadSpec skew;
+        skew.kind = WorkloadKind::Markov;
+        skew.length = TEXT_LENGTH;
+        skew.seed = skewRng();
+        double rest = (1.0 - share) / 3;
+        for (auto& row : skew.transitions) row = {{share, rest, rest, rest}};
+        generateWorkload(skew, out);
+    };
+    string skewedText;
+    skewedWorkload(0.7, skewedText);
+    cout << "Pola skew tinggi (256 bp, ~70% A), teks kaya A:" << endl;
+    CompiledPattern skewed = compilePattern(string_view(skewedText).substr(rng() % (TEXT_LENGTH - 256), 256));
+    config.skewedEngine = fastest({EngineKind::KmpDfa, EngineKind::TwoWay, EngineKind::Simd, EngineKind::Bndm},
+                                  {{skewedText, &skewed}});
+
+    // 4. skew_limit: skew terkecil di mana skewedEngine mengalahkan rute biasa (SIMD/BNDM)
+    //    pada skew itu dan semua skew di atasnya
+    EngineKind normalEngine = (256 >= config.bndmMinLength) ? EngineKind::Bndm : EngineKind::Simd;
+    // Tidak pernah menang -> batas di atas skew maksimum (1.0 = pola satu simbol), rute skew mati
+    config.skewLimit = 1.01;
+    if (config.skewedEngine == normalEngine) {
+        cout << "skew_limit dimatikan: skewed_engine sama dengan rute biasa (" << engineName(normalEngine) << ")" << endl;
+    } else {
+        cout << left << setw(8) << "skew" << setw(12) << string(engineName(normalEngine)) + "(ms)"
+             << setw(12) << string(engineName(config.skewedEngine)) + "(ms)" << endl;
+        vector<pair<double, bool>> skewedWins;
+        for (int percent = 30; percent <= 90; percent += 10) {
+            skewedWorkload(percent / 100.0, skewedText);
+            CompiledPattern cp = compilePattern(string_view(skewedText).substr(rng() % (TEXT_LENGTH - 256), 256));
+            double normal = bestTime(normalEngine, skewedText, cp);
+            double special = bestTime(config.skewedEngine, skewedText, cp);
+            skewedWins.push_back({cp.profile.skew, special < normal});
+            cout << left << setw(8) << setprecision(2) << cp.profile.skew << setprecision(4)
+                 << setw(12) << normal << setw(12) << special << endl;
+        }
+        for (size_t i = skewedWins.size(); i-- > 0 && skewedWins[i].second;) config.skewLimit = skewedWins[i].first;
+    }
+
+    cout << "--------------------------------------------------------------------------" << endl;
+    cout << "bndm_min_length " << (config.bndmMinLength == SIZE_MAX ? string("tidak pernah") : to_string(config.bndmMinLength))
+         << ", periodic_engine " << engineName(config.periodicEngine)
+         << ", skewed_engine " << engineName(config.skewedEngine)
+         << ", skew_limit " << setprecision(2) << config.skewLimit << setprecision(4) << endl;
+    if (!config.save(opt.dispatchFile)) {
+        cout << "Error: tidak bisa menulis " << opt.dispatchFile << endl;
+        return;
+    }
+    cout << "Kalibrasi disimpan ke " << opt.dispatchFile << endl;
+
+    // Cek ulang lewat file yang baru ditulis: pola periodik (menurut LPS) harus
+    // tetap dirutekan ke engine linear, bukan SIMD/BNDM
+    DispatchConfig reloaded;
+    reloaded.load(opt.dispatchFile);
+    EngineDispatcher dispatcher(reloaded);
+    bool linear = true;
+    for (const CompiledPattern& cp : periodicProbes) {
+        EngineKind kind = dispatcher.choose(cp);
+        if (cp.profile.periodic() && !linearEngine(kind)) {
+            cout << "Error: pola periodik m " << cp.profile.length << " dirutekan ke " << engineName(kind) << endl;
+            linear = false;
+        }
+    }
+    if (linear) cout << "Cek rute periodik: OK (" << engineName(reloaded.periodicEngine) << ")" << endl;
+}
+
+// ==========================================
+// BENCHMARK HARNESS
+// ==========================================
+// Setiap engine dijalankan pada setiap workload: beberapa warmup, lalu N trial
+// yang diukur dengan steady_clock (resolusi ns). Proses di-pin ke satu CPU
+// supaya hasil antar run bisa dibandingkan.
+struct BenchWorkload {
+    string name;
+    string storage;                 // teks sintetis / sekuens FASTA-FASTQ (kosong untuk korpus mmap)
+    vector<string_view> records;
+    vector<PackedSeq> packed;       // versi 2-bit, dibuat di luar pengukuran
+    size_t bytes = 0;
+    long long expectedMatches = -1; // jumlah kemunculan yang ditanam, -1 = tidak diketahui
+    CompiledPattern pattern;
+};
+
+struct BenchEngine {
+    string name;
+    function<AnalysisResult(string_view, const PackedSeq&, const CompiledPattern&, MatchSink*)> run;
+};
+
+struct BenchResult {
+    string workload;
+    string engine;
+    size_t bytes;
+    int trials;
+    double medianMs;
+    double locateMedianMs;  // engine yang sama dengan SpanSink (mode locate)
+    double p95Ms;
+    double minMs;
+    double gbps;
+    long long matches;
+};
+
+// Persentil nearest-rank dari sampel yang sudah terurut
+double percentile(const vector<double>& sorted, double pct) {
+    if (sorted.empty()) return 0;
+    size_t rank = (size_t)ceil(pct / 100.0 * sorted.size());
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+bool pinToCpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void finishWorkload(BenchWorkload& w) {
+    w.bytes = 0;
+    w.packed.resize(w.records.size());
+    for (size_t r = 0; r < w.records.size(); r++) {
+        w.bytes += w.records[r].size();
+        packSequenceInto(w.records[r], w.packed[r]);
+    }
+}
+
+vector<BenchEngine> benchEngines(const EngineDispatcher& dispatcher) {
+    return {
+        {"Naive",    [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return naiveSearch(t, cp, sink); }},
+        {"KMP",      [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return kmpSearch(t, cp, sink); }},
+        {"NaiveFast", [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return naiveSearchFast(t, cp, sink); }},
+        {"KMPFast",  [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return kmpSearchFast(t, cp, sink); }},
+        {"KMP-DFA",  [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return kmpDfaSearch(t, cp, sink); }},
+        {"TwoWay",   [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return twoWaySearch(t, cp, sink); }},
+        {"SIMD",     [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return simdSearch(t, cp, sink); }},
+        {"ShiftAnd", [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return shiftAndSearch(t, cp, sink); }},
+        {"BNDM",     [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return bndmSearch(t, cp, sink); }},
+        {"Naive2b",  [](string_view, const PackedSeq& p, const CompiledPattern& cp, MatchSink* sink) { return naiveSearchPacked(p, cp, sink); }},
+        {"KMP2b",    [](string_view, const PackedSeq& p, const CompiledPattern& cp, MatchSink* sink) { return kmpSearchPacked(p, cp, sink); }},
+        {"Myers-k2", [](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return myersSearch(t, cp, 2, nullptr, 0, sink); }},
+        {"Auto",     [&dispatcher](string_view t, const PackedSeq&, const CompiledPattern& cp, MatchSink* sink) { return dispatcher.search(t, cp, sink); }},
+    };
+}
+
+// Baseline CSV: workload,engine,...,median_ms,... -> median per (workload, engine)
+map<pair<string, string>, double> loadBaseline(const string& path) {
+    map<pair<string, string>, double> baseline;
+    ifstream file(path);
+    string line;
+    getline(file, line);    // header
+    while (getline(file, line)) {
+        stringstream row(line);
+        string workload, engine, bytes, trials, median;
+        getline(row, workload, ',');
+        getline(row, engine, ',');
+        getline(row, bytes, ',');
+        getline(row, trials, ',');
+        getline(row, median, ',');
+        if (!median.empty()) baseline[{workload, engine}] = atof(median.c_str());
+    }
+    return baseline;
+}
+
+int runBenchmark(const AnalysisOptions& opt) {
+    int cpu = (opt.cpu >= 0) ? opt.cpu : sched_getcpu();
+    bool pinned = cpu >= 0 && pinToCpu(cpu);
+
+    // --- Workload ---
+    const uint64_t CAG_TEXT_LENGTH = 100000;     // Naive O(n*m) di sini, jadi teks dibuat kecil
+    const uint64_t RANDOM_TEXT_LENGTH = 4 << 20;
+    const uint64_t PLANT_COUNT = 32;
+    vector<BenchWorkload> workloads;
+    workloads.reserve(5);
+
+    // Teks sintetis dari generator ber-seed, jadi identik antar run dan antar mesin
+    auto addSynthetic = [&](const string& name, const WorkloadSpec& spec, const string& pattern) {
+        workloads.emplace_back();
+        BenchWorkload& w = workloads.back();
+        w.name = name;
+        vector<uint64_t> planted = generateWorkload(spec, w.storage);
+        if (!spec.plant.empty()) w.expectedMatches = (long long)planted.size();
+        w.records.push_back(w.storage);
+        w.pattern = compilePattern(pattern);
+        finishWorkload(w);
+    };
+
+    string cagPattern;
+    for (int i = 0; i < 1000; i++) cagPattern += "CAG";
+    cagPattern += "T";
+    WorkloadSpec cag;
+    cag.kind = WorkloadKind::Repeat;
+    cag.length = CAG_TEXT_LENGTH;
+    addSynthetic("cag-repeat", cag, cagPattern);
+
+    WorkloadSpec random;
+    random.length = RANDOM_TEXT_LENGTH;
+    addSynthetic("random-acgt", random, GENE_PROBE);
+
+    WorkloadSpec markov;
+    markov.kind = WorkloadKind::Markov;
+    markov.length = RANDOM_TEXT_LENGTH;
+    addSynthetic("markov", markov, GENE_PROBE);
+
+    WorkloadSpec planted = random;
+    planted.seed = 7;
+    planted.plant = GENE_PROBE;
+    planted.plantCount = PLANT_COUNT;
+    addSynthetic("planted", planted, GENE_PROBE);
+
+    // Workload korpus dari --input (default human.txt). Record mmap dirujuk
+    // langsung; FASTA/FASTQ disalin ke storage lalu di-view setelah semua terbaca.
+    RecordSource source;
+    if (source.open(opt.inputFile)) {
+        workloads.emplace_back();
+        BenchWorkload& corpusWork = workloads.back();
+        corpusWork.name = (opt.inputFile == "-") ? string("stdin") : opt.inputFile;
+        DnaRecord rec;
+        FastxRecord storage;
+        vector<pair<size_t, size_t>> spans;
+        while (source.next(rec, storage)) {
+            if (!source.isFastx()) {
+                corpusWork.records.push_back(rec.sequence);
+                continue;
+            }
+            spans.push_back({corpusWork.storage.size(), rec.sequence.size()});
+            corpusWork.storage.append(rec.sequence);
+        }
+        for (auto& span : spans) corpusWork.records.push_back(string_view(corpusWork.storage).substr(span.first, span.second));
+        corpusWork.pattern = compilePattern(GENE_PROBE);
+        finishWorkload(corpusWork);
+        if (corpusWork.records.empty()) workloads.pop_back();
+    } else {
+        cout << "Catatan: " << opt.inputFile << " tidak ditemukan, workload korpus dilewati." << endl;
+    }
+
+    map<pair<string, string>, double> baseline;
+    if (!opt.baselineFile.empty()) baseline = loadBaseline(opt.baselineFile);
+
+    DispatchConfig dispatchConfig;
+    dispatchConfig.load(opt.dispatchFile);
+    EngineDispatcher dispatcher(dispatchConfig);
+
+    cout << fixed << setprecision(4);
+    cout << "\nBENCHMARK SUITE (warmup " << opt.warmups << ", trial " << opt.trials << ", CPU "
+         << (pinned ? to_string(cpu) : string("tidak di-pin")) << ", SIMD " << simdPathName(activeSimdPath) << ")" << endl;
+    cout << "==============================================================================================================" << endl;
+    cout << left << setw(13) << "Workload" 
+         << setw(10) << "Engine" 
+         << setw(12) << "Median(ms)" 
+         << setw(12) << "Locate(ms)" 
+         << setw(12) << "p95(ms)" 
+         << setw(12) << "Min(ms)" 
+         << setw(10) << "GB/s" 
+         << setw(10) << "Match" 
+         << "Status" << endl;
+    cout << "--------------------------------------------------------------------------------------------------------------" << endl;
+
+    // Mode locate: posisi ditulis ke buffer tetap milik pemanggil, di-reset per record
+    const size_t LOCATE_CAPACITY = 1 << 16;
+    vector<uint64_t> locateBuffer(LOCATE_CAPACITY);
+    SpanSink locateSink(locateBuffer.data(), LOCATE_CAPACITY);
+
+    vector<BenchResult> results;
+    int regressions = 0;
+    for (const BenchWorkload& w : workloads) {
+        long long referenceMatches = w.expectedMatches;
+        for (const BenchEngine& e : benchEngines(dispatcher)) {
+            // Sampel terurut (ms); matches dan located dari trial terakhir
+            auto runTrials = [&](MatchSink* sink, long long& matches, long long& located) {
+                vector<double> samples;
+                for (int t = 0; t < opt.warmups + opt.trials; t++) {
+                    matches = 0;
+                    located = 0;
+                    auto start = chrono::steady_clock::now();
+                    for (size_t r = 0; r < w.records.size(); r++) {
+                        locateSink.clear();
+                        matches += e.run(w.records[r], w.packed[r], w.pattern, sink).matches;
+                        located += locateSink.size() + locateSink.dropped();
+                    }
+                    auto end = chrono::steady_clock::now();
+                    chrono::duration<double, milli> elapsed = end - start;
+                    if (t >= opt.warmups) samples.push_back(elapsed.count());
+                }
+                sort(samples.begin(), samples.end());
+                return samples;
+            };
+
+            long long matches = 0, located = 0, locateMatches = 0;
+            vector<double> samples = runTrials(nullptr, matches, located);
+            vector<double> locateSamples = runTrials(&locateSink, locateMatches, located);
+
+            BenchResult res;
+            res.workload = w.name;
+            res.engine = e.name;
+            res.bytes = w.bytes;
+            res.trials = opt.trials;
+            res.medianMs = percentile(samples, 50);
+            res.locateMedianMs = percentile(locateSamples, 50);
+            res.p95Ms = percentile(samples, 95);
+            res.minMs = samples.empty() ? 0 : samples.front();
+            res.gbps = (res.medianMs > 0) ? (w.bytes / 1e9) / (res.medianMs / 1000.0) : 0;
+            res.matches = matches;
+            results.push_back(res);
+
+            // Myers menghitung posisi akhir dengan jarak <= 2, tidak dibandingkan dengan exact
+            if (referenceMatches < 0) referenceMatches = matches;
+            bool exact = e.name.rfind("Myers", 0) != 0;
+            string status = (exact && matches != referenceMatches) ? "MATCH-BEDA" : "OK";
+            if (located != locateMatches || locateMatches != matches) status = "LOCATE-BEDA";
+            auto base = baseline.find({w.name, e.name});
+            if (base != baseline.end() && base->second > 0) {
+                double change = (res.medianMs / base->second - 1.0) * 100.0;
+                stringstream delta;
+                delta << fixed << setprecision(1) << showpos << change << "%";
+                if (change > opt.threshold) {
+                    status = "REGRESI " + delta.str();
+                    regressions++;
+                } else {
+                    status += " " + delta.str();
+                }
+            }
+
+            cout << left << setw(13) << res.workload 
+                 << setw(10) << res.engine 
+                 << setw(12) << res.medianMs 
+                 << setw(12) << res.locateMedianMs 
+                 << setw(12) << res.p95Ms 
+                 << setw(12) << res.minMs 
+                 << setw(10) << res.gbps 
+                 << setw(10) << res.matches 
+                 << status << endl;
+        }
+        cout << "--------------------------------------------------------------------------------------------------------------" << endl;
+    }
+
+    // Biaya counter: engine yang sama dengan CountingStats vs NoStats
+    cout << "Overhead counter (median CountingStats / NoStats):" << endl;
+    for (const BenchWorkload& w : workloads) {
+        for (const auto& pairName : {make_pair("Naive", "NaiveFast"), make_pair("KMP", "KMPFast")}) {
+            double counted = 0, plain = 0;
+            for (const BenchResult& r : results) {
+                if (r.workload != w.name) continue;
+                if (r.engine == pairName.first) counted = r.medianMs;
+                if (r.engine == pairName.second) plain = r.medianMs;
+            }
+            if (plain <= 0) continue;
+            cout << "  " << left << setw(13) << w.name << setw(6) << pairName.first << setprecision(2)
+                 << counted / plain << "x (" << setprecision(4) << counted << " ms vs " << plain << " ms)" << endl;
+        }
+    }
+
+    if (!opt.csvFile.empty()) {
+        ofstream csv(opt.csvFile);
+        csv << "workload,engine,bytes,trials,median_ms,p95_ms,min_ms,gbps,matches,locate_median_ms\n";
+        csv << fixed << setprecision(6);
+        for (const BenchResult& r : results) {
+            csv << r.workload << ',' << r.engine << ',' << r.bytes << ',' << r.trials << ',' << r.medianMs << ','
+                << r.p95Ms << ',' << r.minMs << ',' << r.gbps << ',' << r.matches << ',' << r.locateMedianMs << '\n';
+        }
+        cout << "CSV ditulis ke " << opt.csvFile << endl;
+    }
+    if (!opt.jsonFile.empty()) {
+        ofstream json(opt.jsonFile);
+        json << fixed << setprecision(6) << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            json << "  {\"workload\": \"" << r.workload << "\", \"engine\": \"" << r.engine
+                 << "\", \"bytes\": " << r.bytes << ", \"trials\": " << r.trials
+                 << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+                 << ", \"min_ms\": " << r.minMs << ", \"gbps\": " << r.gbps
+                 << ", \"matches\": " << r.matches << ", \"locate_median_ms\": " << r.locateMedianMs << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        json << "]\n";
+        cout << "JSON ditulis ke " << opt.jsonFile << endl;
+    }
+    if (!baseline.empty()) {
+        cout << "Baseline " << opt.baselineFile << ": " << regressions << " regresi (> " << setprecision(1)
+             << opt.threshold << "% lebih lambat)." << endl;
+    }
+    return regressions > 0 ? 2 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    AnalysisOptions opt;
+    for (int a = 1; a < argc; a++) {
+        string arg = argv[a];
+        if (arg == "--packed") opt.packed = true;
+        else if (arg == "--patterns" && a + 1 < argc) opt.patternsFile = argv[++a];
+        else if (arg == "--max-edits" && a + 1 < argc) opt.maxEdits = max(0, atoi(argv[++a]));
+        else if (arg == "--perf") opt.perf = true;
+        else if (arg == "--build-index" && a + 1 < argc) opt.buildIndexFile = argv[++a];
+        else if (arg == "--query-index" && a + 1 < argc) opt.queryIndexFile = argv[++a];
+        else if (arg == "--bench") opt.bench = true;
+        else if (arg == "--warmup" && a + 1 < argc) opt.warmups = max(0, atoi(argv[++a]));
+        else if (arg == "--trials" && a + 1 < argc) opt.trials = max(1, atoi(argv[++a]));
+        else if (arg == "--cpu" && a + 1 < argc) opt.cpu = atoi(argv[++a]);
+        else if (arg == "--csv" && a + 1 < argc) opt.csvFile = argv[++a];
+        else if (arg == "--json" && a + 1 < argc) opt.jsonFile = argv[++a];
+        else if (arg == "--baseline" && a + 1 < argc) opt.baselineFile = argv[++a];
+        else if (arg == "--threshold" && a + 1 < argc) opt.threshold = atof(argv[++a]);
+        else if (arg == "--threads" && a + 1 < argc) opt.threads = max(0, atoi(argv[++a]));
+        else if (arg == "--stream" && a + 1 < argc) opt.streamFile = argv[++a];
+        else if (arg == "--input" && a + 1 < argc) opt.inputFile = argv[++a];
+        else if (arg == "--calibrate") opt.calibrate = true;
+        else if (arg == "--dispatch" && a + 1 < argc) opt.dispatchFile = argv[++a];
+        else if (arg == "--chunk" && a + 1 < argc) opt.chunkSize = (size_t)max(1LL, atoll(argv[++a]));
+        else if (arg == "--both-strands") opt.bothStrands = true;
+        else if (arg == "--top" && a + 1 < argc) opt.topKmers = max(0, atoi(argv[++a]));
+        else if (arg == "--spectrum" && a + 1 < argc) opt.spectrumFile = argv[++a];
+        else if (arg == "--kmer" && a + 1 < argc) {
+            opt.kmerLength = atoi(argv[++a]);
+            if (opt.kmerLength < 1 || opt.kmerLength > KMER_MAX_K) {
+                cout << "Panjang k-mer harus 1.." << KMER_MAX_K << ": " << argv[a] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--tiled") opt.tiled = true;
+        else if (arg == "--tile" && a + 1 < argc) opt.tileBytes = (size_t)parseByteSize(argv[++a]);
+        else if (arg == "--matrix" && a + 1 < argc) opt.matrixFile = argv[++a];
+        else if (arg == "--generate" && a + 1 < argc) opt.generateFile = argv[++a];
+        else if (arg == "--gen-length" && a + 1 < argc) opt.workload.length = parseByteSize(argv[++a]);
+        else if (arg == "--seed" && a + 1 < argc) opt.workload.seed = strtoull(argv[++a], nullptr, 10);
+        else if (arg == "--mutation" && a + 1 < argc) opt.workload.mutationRate = atof(argv[++a]);
+        else if (arg == "--plant-count" && a + 1 < argc) {
+            opt.workload.plant = GENE_PROBE;
+            opt.workload.plantCount = strtoull(argv[++a], nullptr, 10);
+        }
+        else if (arg == "--gen-kind" && a + 1 < argc) {
+            if (!parseWorkloadKind(argv[++a], opt.workload.kind)) {
+                cout << "Jenis workload tidak dikenal: " << argv[a] << " (uniform, markov, repeat)" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--motif" && a + 1 < argc) {
+            string motif = argv[++a];
+            for (char& c : motif) c = (char)toupper((unsigned char)c);
+            if (motif.empty() || !all_of(motif.begin(), motif.end(), [](char c) { return baseCode(c) >= 0; })) {
+                cout << "Motif harus berisi basa ACGT: " << argv[a] << endl;
+                return 1;
+            }
+            opt.workload.motif = motif;
+        }
+        else {
+            cout << "Opsi tidak dikenal: " << arg << endl;
+            return 1;
+        }
+    }
+
+    // Mode index bekerja pada seluruh korpus, tanpa batas jumlah sekuens
+    if (!opt.buildIndexFile.empty()) runIndexBuild(opt.buildIndexFile, opt.inputFile);
+    if (!opt.queryIndexFile.empty()) runIndexQuery(opt.queryIndexFile, opt.inputFile);
+    if (!opt.buildIndexFile.empty() || !opt.queryIndexFile.empty()) return 0;
+
+    if (opt.calibrate) {
+        runCalibration(opt);
+        return 0;
+    }
+
+    if (!opt.generateFile.empty()) {
+        runGenerate(opt);
+        return 0;
+    }
+
+    if (opt.bench) return runBenchmark(opt);
+
+    if (!opt.streamFile.empty()) {
+        runStreamSearch(opt);
+        return 0;
+    }
+
+    if (opt.kmerLength > 0) {
+        runKmerSpectrum(opt);
+        return 0;
+    }
+
+    int limit;
+    cout << "--- DNA Matching Memory Analysis ---" << endl;
+    if (opt.inputFile == "-") {
+        // stdin berisi data FASTA/FASTQ, jadi tidak ada prompt: semua record diproses
+        limit = INT_MAX;
+    } else {
+        cout << "Masukkan jumlah sekuens yang ingin dicek: ";
+        cin >> limit;
+    }
+
+    if (opt.tiled) {
+        runTiledBatch(limit, opt);
+        return 0;
+    }
+
+    if (!opt.patternsFile.empty()) {
+        runMultiPatternAnalysis(limit, opt);
+        return 0;
+    }
 
-    runAnalysis(limit);
+    runAnalysis(limit, opt);
 
     cout << "\nKeterangan:" << endl;
     cout << "- InputMem : Memori untuk menyimpan teks DNA dan pola pencarian." << endl;
     cout << "- LPS Mem  : Memori tambahan array (Longest Prefix Suffix) pada KMP." << endl;
-    cout << "- StackMem : Estimasi memori variabel lokal (int, iterator, dll)." << endl;
+    cout << "- StackMem : Stack terdalam yang dipakai engine (diukur dengan stack painting)." << endl;
+    cout << "- HeapPeak : Puncak byte heap hidup selama pemanggilan engine; Allocs = jumlah alokasi." << endl;
+    cout << "- TOTAL MEM: InputMem + LPS Mem + StackMem + HeapPeak (tabel diukur saat kompilasi pola)." << endl;
+    cout << "- KMP-DFA  : LPS Mem = tabel LPS + tabel transisi DFA (m+1) x 5 int32." << endl;
+    cout << "- TwoWay   : Crochemore-Perrin, linear seperti KMP; LPS Mem = faktorisasi kritis saja (konstan)." << endl;
+    cout << "- ShiftAnd/BNDM: LPS Mem = tabel mask bit-parallel per simbol + bit vector D." << endl;
+    if (opt.maxEdits >= 0) cout << "- Myers-kK : Match = jumlah posisi akhir dengan edit distance <= K; akhir/jarak per posisi." << endl;
+    cout << "- SIMD     : Filter byte pertama/terakhir per blok (jalur " << simdPathName(activeSimdPath)
+         << "); Comp. = jumlah blok + kandidat yang diverifikasi." << endl;
+    if (opt.perf) cout << "- --perf   : counter user space per pemanggilan engine; IPC = Instr / Cycles, n/a = tidak tersedia." << endl;
+    if (opt.threads != 1) cout << "- --threads: record dianalisis paralel (reader -> worker -> writer), urutan output sama dengan mode serial." << endl;
+    if (opt.inputFile != "human.txt") cout << "- --input  : FASTA/FASTQ dibaca streaming; Class '-' = tanpa kelas, basa huruf kecil (soft-mask) dijadikan huruf besar." << endl;
+    if (opt.bothStrands) cout << "- 2Strand  : pola + reverse complement dalam satu automaton (satu scan); Match = jumlah hit untai + dan untai -." << endl;
+    cout << "- A:xxx    : engine yang dipilih dispatcher otomatis untuk pola ini (kalibrasi: --calibrate)." << endl;
+    if (opt.packed) cout << "- Mode --packed: InputMem dihitung dari representasi 2-bit (4 basa per byte)." << endl;
     
     return 0;
 }
\ No newline at end of file
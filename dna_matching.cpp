@@ -3,6 +3,14 @@
 #include <string>
 #include <chrono>
 #include <sys/resource.h>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
 
 using namespace std;
 using namespace std::chrono;
@@ -74,8 +82,209 @@ int KMPSearch(const string& text, const string& pattern, size_t& extraMemKMP) {
     return count;
 }
 
+// ==========================================
+// ALGORITMA TWO-WAY (CROCHEMORE-PERRIN)
+// ==========================================
+
+// Suffix maksimal (reversed = urutan huruf terbalik); kembalikan indeks awal - 1
+int maxSuffix(const string& x, bool reversed, int& period) {
+    int ms = -1, j = 0, k = 1;
+    int m = x.length();
+    period = 1;
+    while (j + k < m) {
+        char a = x[j + k];
+        char b = x[ms + k];
+        if (reversed ? a > b : a < b) { j += k; k = 1; period = j - ms; }
+        else if (a == b) {
+            if (k != period) k++;
+            else { j += period; k = 1; }
+        } else { ms = j; j = ms + 1; k = period = 1; }
+    }
+    return ms;
+}
+
+// Waktu linear seperti KMP tetapi memori tambahan konstan (ell, per, memory)
+int twoWaySearch(const string& text, const string& pattern, size_t& extraMemTwoWay) {
+    int n = text.length();
+    int m = pattern.length();
+    int count = 0;
+    extraMemTwoWay = 3 * sizeof(int);
+    if (m == 0) return 0;
+
+    int p, q;
+    int i = maxSuffix(pattern, false, p);
+    int j = maxSuffix(pattern, true, q);
+    int ell = (i > j) ? i : j;
+    int per = (i > j) ? p : q;
+    bool periodic = per + ell + 1 <= m && pattern.compare(0, ell + 1, pattern, per, ell + 1) == 0;
+    if (!periodic) per = max(ell + 1, m - ell - 1) + 1;
+
+    int memory = -1;
+    int pos = 0;
+    while (pos <= n - m) {
+        int k = (periodic ? max(ell, memory) : ell) + 1;
+        while (k < m && pattern[k] == text[pos + k]) k++;
+        if (k < m) {
+            pos += k - ell;
+            memory = -1;
+            continue;
+        }
+        int leftEnd = periodic ? memory : -1;
+        k = ell;
+        while (k > leftEnd && pattern[k] == text[pos + k]) k--;
+        if (k <= leftEnd) count++;
+        pos += per;
+        if (periodic) memory = m - per - 1;
+    }
+    return count;
+}
+
+// ==========================================
+// PENCARIAN PARALEL (CHUNK + WORK STEALING)
+// ==========================================
+
+// KMP pada potongan text[0..n) dengan tabel LPS yang sudah dihitung.
+// Hanya match yang dimulai sebelum ownedEnd yang dihitung.
+size_t KMPSearchRange(const char* text, size_t n, size_t ownedEnd, const string& pattern, const vector<int>& lps) {
+    size_t m = pattern.length();
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < n) {
+        if (pattern[j] == text[i]) { j++; i++; }
+        if (j == m) {
+            if (i - m < ownedEnd) count++;
+            j = lps[j - 1];
+        } else if (i < n && pattern[j] != text[i]) {
+            if (j != 0) j = lps[j - 1];
+            else i = i + 1;
+        }
+    }
+    return count;
+}
+
+// Thread pool sederhana: tiap worker punya deque sendiri, ambil tugas dari
+// belakang deque miliknya dan "mencuri" dari depan deque worker lain.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threadCount) {
+        for (unsigned t = 0; t < threadCount; t++) queues.emplace_back(new TaskQueue());
+        for (unsigned t = 0; t < threadCount; t++) workers.emplace_back(&WorkStealingPool::workerLoop, this, t);
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (thread& w : workers) w.join();
+    }
+
+    void submit(function<void()> task) {
+        unsigned target = nextQueue++ % queues.size();
+        // Push dan counter dalam satu critical section (urutan lock: deque lalu
+        // stateMutex, sama dengan tryPop), jadi queued selalu sama dengan jumlah
+        // task di semua deque dan task tidak pernah terambil sebelum dihitung
+        {
+            lock_guard<mutex> queueLock(queues[target]->mtx);
+            queues[target]->tasks.push_back(move(task));
+            lock_guard<mutex> lock(stateMutex);
+            pending++;
+            queued++;
+        }
+        workAvailable.notify_one();
+    }
+
+    void wait() {
+        unique_lock<mutex> lock(stateMutex);
+        allDone.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    struct TaskQueue {
+        mutex mtx;
+        deque<function<void()>> tasks;
+    };
+
+    bool tryPop(unsigned self, function<void()>& task) {
+        for (size_t k = 0; k < queues.size(); k++) {
+            TaskQueue& q = *queues[(self + k) % queues.size()];
+            lock_guard<mutex> lock(q.mtx);
+            if (q.tasks.empty()) continue;
+            if (k == 0) { task = move(q.tasks.back()); q.tasks.pop_back(); }
+            else        { task = move(q.tasks.front()); q.tasks.pop_front(); }
+            lock_guard<mutex> stateLock(stateMutex);
+            queued--;
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned self) {
+        while (true) {
+            function<void()> task;
+            if (tryPop(self, task)) {
+                task();
+                if (--pending == 0) {
+                    lock_guard<mutex> lock(stateMutex);
+                    allDone.notify_all();
+                }
+                continue;
+            }
+            // queued > 0 berarti task benar-benar ada di deque; jika worker lain
+            // mengambilnya lebih dulu, queued sudah turun dan worker ini tidur lagi
+            unique_lock<mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0) return;
+        }
+    }
+
+    vector<unique_ptr<TaskQueue>> queues;
+    vector<thread> workers;
+    atomic<unsigned> nextQueue{0};
+    atomic<size_t> pending{0};
+    size_t queued = 0;          // dilindungi stateMutex
+    bool stopping = false;      // dilindungi stateMutex
+    mutex stateMutex;
+    condition_variable workAvailable;
+    condition_variable allDone;
+};
+
+// Teks dibagi menjadi potongan yang saling tumpang tindih m-1 byte agar match
+// di perbatasan tetap ditemukan; tiap match dihitung oleh potongan tempat ia dimulai.
+size_t parallelKMPSearch(const string& text, const string& pattern, unsigned threadCount) {
+    size_t n = text.length();
+    size_t m = pattern.length();
+    if (m == 0 || m > n) return 0;
+
+    vector<int> lps(m);
+    computeLPSArray(pattern, m, lps);
+
+    // Lebih banyak potongan daripada thread supaya work stealing bisa menyeimbangkan beban
+    size_t chunkCount = max<size_t>(1, min<size_t>(threadCount * 8, n / m));
+    size_t chunkSize = (n + chunkCount - 1) / chunkCount;
+
+    vector<size_t> counts(chunkCount, 0);
+    WorkStealingPool pool(threadCount);
+    for (size_t c = 0; c < chunkCount; c++) {
+        pool.submit([&, c] {
+            size_t begin = c * chunkSize;
+            if (begin >= n) return;
+            size_t ownedEnd = min(n, begin + chunkSize);
+            size_t end = min(n, ownedEnd + m - 1);
+            counts[c] = KMPSearchRange(text.data() + begin, end - begin, ownedEnd - begin, pattern, lps);
+        });
+    }
+    pool.wait();
+
+    size_t total = 0;
+    for (size_t c : counts) total += c;
+    return total;
+}
+
 int main() {
-    const int TEXT_LENGTH = 1000000; 
+    const size_t TEXT_LENGTH = 1000000; 
     const int PATTERN_REPEAT_COUNT = 1000; 
     const string MOTIF = "CAG"; 
     
@@ -90,8 +299,8 @@ int main() {
 
     string text;
     text.reserve(TEXT_LENGTH);
-    while (text.length() < TEXT_LENGTH) text += MOTIF;
-    text = text.substr(0, TEXT_LENGTH);
+    // Potongan motif terakhir dipotong saat ditambahkan, jadi tidak perlu substr (salinan kedua)
+    while (text.length() < TEXT_LENGTH) text.append(MOTIF, 0, min(MOTIF.length(), TEXT_LENGTH - text.length()));
 
     // 2. Cek Memori Setelah String Dimuat
     long memAfterData = getPeakRSS();
@@ -112,6 +321,12 @@ int main() {
     int matchesKMP = KMPSearch(text, pattern, extraMemKMP);
     auto stopKMP = high_resolution_clock::now();
 
+    // --- EKSEKUSI TWO-WAY ---
+    size_t extraMemTwoWay = 0;
+    auto startTwoWay = high_resolution_clock::now();
+    int matchesTwoWay = twoWaySearch(text, pattern, extraMemTwoWay);
+    auto stopTwoWay = high_resolution_clock::now();
+
     // ==========================================
     // HASIL ANALISIS
     // ==========================================
@@ -123,10 +338,36 @@ int main() {
     cout << "\nKMP Algorithm:" << endl;
     cout << "  - Time         : " << duration_cast<milliseconds>(stopKMP - startKMP).count() << " ms" << endl;
     cout << "  - Extra Memory : " << extraMemKMP << " bytes (LPS Table)" << endl;
-    cout << "    (Pattern Length " << pattern.length() << " * " << sizeof(int) << " bytes)" << endl << endl;
+    cout << "    (Pattern Length " << pattern.length() << " * " << sizeof(int) << " bytes)" << endl;
+
+    cout << "\nTwo-Way Algorithm:" << endl;
+    cout << "  - Time         : " << duration_cast<milliseconds>(stopTwoWay - startTwoWay).count() << " ms" << endl;
+    cout << "  - Extra Memory : " << extraMemTwoWay << " bytes (faktorisasi kritis, konstan)" << endl;
+    cout << "  - Matches      : " << matchesTwoWay << (matchesTwoWay == matchesKMP ? " (sama dengan KMP)" : " (BEDA dengan KMP)") << endl << endl;
 
     cout << "Summary:" << endl;
     cout << "KMP membutuhkan " << extraMemKMP << " bytes memori tambahan untuk mempercepat pencarian." << endl;
+    cout << "Two-Way tetap linear pada workload CAG...T ini dengan hanya " << extraMemTwoWay << " bytes." << endl;
+
+    // --- EKSEKUSI KMP PARALEL ---
+    duration<double, milli> baseKMP = stopKMP - startKMP;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+
+    cout << "\n--- Parallel KMP (chunk overlap m-1, work stealing) ---" << endl;
+    cout << "Threads   Time(ms)    Speedup   Matches   Status" << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        auto startPar = high_resolution_clock::now();
+        size_t matchesPar = parallelKMPSearch(text, pattern, threads);
+        auto stopPar = high_resolution_clock::now();
+        duration<double, milli> elapsed = stopPar - startPar;
+
+        cout << left << fixed << setprecision(3)
+             << setw(10) << threads
+             << setw(12) << elapsed.count()
+             << setw(10) << setprecision(2) << baseKMP.count() / elapsed.count()
+             << setw(10) << matchesPar
+             << (matchesPar == (size_t)matchesKMP ? "OK" : "MISMATCH") << endl;
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+// Representasi 2-bit bersama untuk DNA_Pattern_Matching.cpp dan tes.cpp
+// (keduanya program satu file; header ini satu-satunya kode yang dipakai bersama).
+#ifndef PACKED_SEQ_H
+#define PACKED_SEQ_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// ==========================================
+// REPRESENTASI 2-BIT (PACKED NUCLEOTIDE)
+// ==========================================
+// A=00 C=01 G=10 T=11, 32 basa per word 64-bit. N dan simbol IUPAC lain
+// ditandai di nmask (1 bit per basa) dan karakter aslinya disimpan di
+// exceptions, sehingga perbandingan tetap eksak seperti versi string.
+struct PackedSeq {
+    size_t length = 0;
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> nmask;                        // kosong jika semua basa ACGT
+    std::vector<std::pair<size_t, char>> exceptions;    // urut berdasarkan posisi
+
+    char at(size_t i) const {
+        if (!nmask.empty() && ((nmask[i >> 6] >> (i & 63)) & 1)) {
+            auto it = std::lower_bound(exceptions.begin(), exceptions.end(), std::make_pair(i, (char)0));
+            return it->second;
+        }
+        return "ACGT"[(bits[i >> 5] >> ((i & 31) * 2)) & 3];
+    }
+};
+
+inline int baseCode(char c) {
+    switch (c) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default:  return -1;
+    }
+}
+
+// Isi ulang p dari s; kapasitas buffer lama dipakai lagi (tanpa alokasi jika cukup)
+inline void packSequenceInto(std::string_view s, PackedSeq& p) {
+    p.length = s.length();
+    p.nmask.clear();
+    p.exceptions.clear();
+    // +1 word padding supaya loadBits boleh membaca word berikutnya tanpa cek batas
+    p.bits.assign(p.length / 32 + 2, 0);
+    for (size_t i = 0; i < p.length; i++) {
+        int code = baseCode(s[i]);
+        if (code < 0) {
+            if (p.nmask.empty()) p.nmask.assign(p.length / 64 + 2, 0);
+            p.nmask[i >> 6] |= 1ULL << (i & 63);
+            p.exceptions.push_back({i, s[i]});
+            code = 0;
+        }
+        p.bits[i >> 5] |= (uint64_t)code << ((i & 31) * 2);
+    }
+}
+
+inline PackedSeq packSequence(std::string_view s) {
+    PackedSeq p;
+    packSequenceInto(s, p);
+    return p;
+}
+
+// Byte representasi sekuens ini (size, bukan capacity): buffer yang dipakai
+// ulang antar record tidak ikut membawa ukuran record terbesar sebelumnya
+inline size_t getPackedMemory(const PackedSeq& p) {
+    return sizeof(PackedSeq) + (p.bits.size() + p.nmask.size()) * sizeof(uint64_t)
+         + p.exceptions.size() * sizeof(std::pair<size_t, char>);
+}
+
+// Ambil 64 bit mulai dari posisi bit sembarang (boleh tidak align ke word)
+inline uint64_t loadBits(const std::vector<uint64_t>& words, size_t bitPos) {
+    size_t w = bitPos >> 6;
+    unsigned shift = bitPos & 63;
+    if (shift == 0) return words[w];
+    return (words[w] >> shift) | (words[w + 1] << (64 - shift));
+}
+
+// Pembaca berurutan di atas PackedSeq: satu word dimuat per 32 basa dan tiap
+// langkah hanya menggeser 2 bit. Exceptions dibaca berurutan, tanpa lower_bound,
+// sehingga symbol() selalu sama dengan karakter asli di posisi itu.
+class PackedCursor {
+public:
+    explicit PackedCursor(const PackedSeq& s) : seq(s), nextWord(s.bits.data()), hasExceptions(!s.nmask.empty()) {
+        word = *nextWord++;
+        if (hasExceptions) nword = seq.nmask[0];
+        decode();
+    }
+
+    char symbol() const { return current; }
+
+    void advance() {
+        pos++;
+        word >>= 2;
+        if ((pos & 31) == 0) word = *nextWord++;
+        if (hasExceptions) {
+            nword >>= 1;
+            if ((pos & 63) == 0) nword = seq.nmask[pos >> 6];
+        }
+        decode();
+    }
+
+    // Lompati basa yang kodenya bukan code, 32 basa per word sekaligus (maksimal
+    // limit basa). Basa exception tidak pernah dilompati: lompatan berhenti di
+    // sana dan decode() membaca karakter aslinya. Kembalikan jumlah basa yang dilewati.
+    size_t skipUntil(unsigned code, size_t limit) {
+        const uint64_t LANES = 0x5555555555555555ULL;
+        uint64_t broadcast = code * LANES;
+        size_t skipped = 0;
+        while (skipped < limit) {
+            size_t cap = limit - skipped;
+            if (hasExceptions) cap = std::min<size_t>(cap, nword ? __builtin_ctzll(nword) : 64 - (pos & 63));
+            if (cap == 0) break;
+            size_t lanes = 32 - (pos & 31);
+            uint64_t x = word ^ broadcast;
+            uint64_t hit = ~(x | (x >> 1)) & LANES;
+            if (lanes < 32) hit &= (1ULL << (2 * lanes)) - 1;
+            size_t k = hit ? __builtin_ctzll(hit) / 2 : lanes;
+            k = std::min(k, cap);
+            skipped += k;
+            pos += k;
+            if (hasExceptions) {
+                if ((pos & 63) == 0) nword = seq.nmask[pos >> 6];
+                else nword >>= k;
+            }
+            if (k < lanes) {
+                word >>= 2 * k;
+                break;
+            }
+            word = *nextWord++;
+        }
+        if (skipped > 0) decode();
+        return skipped;
+    }
+
+private:
+    void decode() {
+        current = "ACGT"[word & 3];
+        if (nword & 1) current = seq.exceptions[nextException++].second;
+    }
+
+    const PackedSeq& seq;
+    const uint64_t* nextWord;
+    bool hasExceptions;
+    size_t pos = 0;
+    uint64_t word = 0;
+    uint64_t nword = 0;
+    size_t nextException = 0;
+    char current = 'A';
+};
+
+// Cek basa non-ACGT pada jendela text[i..i+m) terhadap pattern. Dipanggil
+// hanya jika salah satu sekuens punya exceptions.
+inline bool exceptionsMatch(const PackedSeq& text, size_t i, const PackedSeq& pattern) {
+    size_t m = pattern.length;
+    for (size_t off = 0; off < m; off += 64) {
+        size_t len = std::min<size_t>(64, m - off);
+        uint64_t keep = (len == 64) ? ~0ULL : ((1ULL << len) - 1);
+        uint64_t tm = text.nmask.empty() ? 0 : (loadBits(text.nmask, i + off) & keep);
+        uint64_t pm = pattern.nmask.empty() ? 0 : (pattern.nmask[off >> 6] & keep);
+        if (tm != pm) return false;
+        while (tm) {
+            size_t k = off + __builtin_ctzll(tm);
+            if (text.at(i + k) != pattern.at(k)) return false;
+            tm &= tm - 1;
+        }
+    }
+    return true;
+}
+
+#endif // PACKED_SEQ_H
@@ -4,6 +4,9 @@
 #include <chrono>
 #include <sys/resource.h> // Khusus Linux
 #include <iomanip>
+#include <cstdint>
+#include <algorithm>
+#include "packed_seq.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -63,7 +66,7 @@ AnalysisResult naiveSearch(const string& text, const string& pattern) {
     }
 
     auto stop = high_resolution_clock::now();
-    double duration = duration_cast<milliseconds>(stop - start).count();
+    double duration = chrono::duration<double, milli>(stop - start).count();
 
     return {"Naive", comparisons, duration, matches, inputMem, lpsMem, stackMem, totalMem};
 }
@@ -115,7 +118,7 @@ AnalysisResult KMPSearch(const string& text, const string& pattern) {
     }
 
     auto stop = high_resolution_clock::now();
-    double duration = duration_cast<milliseconds>(stop - start).count();
+    double duration = chrono::duration<double, milli>(stop - start).count();
 
     // -- Perhitungan Memori Teoritis --
     size_t inputMem = getStringMemory(text) + getStringMemory(pattern);
@@ -126,13 +129,100 @@ AnalysisResult KMPSearch(const string& text, const string& pattern) {
     return {"KMP", comparisons, duration, matches, inputMem, lpsMem, stackMem, totalMem};
 }
 
+// ==========================================
+// 3. NAIVE & KMP DI ATAS PACKED 2-BIT
+// ==========================================
+AnalysisResult naiveSearchPacked(const PackedSeq& text, const PackedSeq& pattern) {
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length;
+    size_t m = pattern.length;
+    bool checkExceptions = !text.nmask.empty() || !pattern.nmask.empty();
+
+    // -- Perhitungan Memori Teoritis --
+    size_t inputMem = getPackedMemory(text) + getPackedMemory(pattern);
+    size_t lpsMem = 0;
+    size_t stackMem = (5 * sizeof(size_t)) + sizeof(long long);
+    size_t totalMem = inputMem + stackMem;
+
+    auto start = high_resolution_clock::now();
+
+    // Satu perbandingan = 32 basa (satu word 64-bit)
+    size_t words = (m + 31) / 32;
+    uint64_t lastMask = (m % 32 == 0) ? ~0ULL : ((1ULL << (2 * (m % 32))) - 1);
+    for (size_t i = 0; m > 0 && i + m <= n; i++) {
+        size_t w;
+        for (w = 0; w < words; w++) {
+            comparisons++;
+            uint64_t diff = loadBits(text.bits, 2 * (i + 32 * w)) ^ pattern.bits[w];
+            if (w == words - 1) diff &= lastMask;
+            if (diff) break;
+        }
+        if (w == words && (!checkExceptions || exceptionsMatch(text, i, pattern))) matches++;
+    }
+
+    auto stop = high_resolution_clock::now();
+    double duration = chrono::duration<double, milli>(stop - start).count();
+
+    return {"Naive2b", comparisons, duration, matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
+AnalysisResult KMPSearchPacked(const PackedSeq& text, const PackedSeq& pattern, const string& patternStr) {
+    long long comparisons = 0;
+    int matches = 0;
+    size_t n = text.length;
+    size_t m = pattern.length;
+
+    auto start = high_resolution_clock::now();
+
+    vector<int> lps(m);
+    computeLPSArray(patternStr, m, lps, comparisons);
+
+    // Teks dibaca word demi word lewat PackedCursor; saat j = 0 gagal, basa yang
+    // pasti gagal lagi dilompati per word dan tetap dihitung satu perbandingan.
+    int firstCode = m > 0 ? baseCode(patternStr[0]) : -1;
+    PackedCursor cursor(text);
+    size_t i = 0;
+    size_t j = 0;
+    while (m > 0 && i < n) {
+        comparisons++;
+        if (patternStr[j] == cursor.symbol()) { j++; i++; cursor.advance(); }
+        if (j == m) {
+            matches++;
+            j = lps[j - 1];
+        } else if (i < n && patternStr[j] != cursor.symbol()) {
+            if (j != 0) j = lps[j - 1];
+            else {
+                i = i + 1;
+                cursor.advance();
+                if (firstCode >= 0 && i < n) {
+                    size_t skipped = cursor.skipUntil(firstCode, n - i);
+                    i += skipped;
+                    comparisons += skipped;
+                }
+            }
+        }
+    }
+
+    auto stop = high_resolution_clock::now();
+    double duration = chrono::duration<double, milli>(stop - start).count();
+
+    // -- Perhitungan Memori Teoritis --
+    size_t inputMem = getPackedMemory(text) + getPackedMemory(pattern);
+    size_t lpsMem = sizeof(vector<int>) + (lps.capacity() * sizeof(int));
+    size_t stackMem = (5 * sizeof(size_t)) + sizeof(long long);
+    size_t totalMem = inputMem + lpsMem + stackMem;
+
+    return {"KMP2b", comparisons, duration, matches, inputMem, lpsMem, stackMem, totalMem};
+}
+
 // ==========================================
 // MAIN PROGRAM
 // ==========================================
 int main() {
     // SAYA UBAH KE 10 JUTA AGAR LAPTOP ANDA TIDAK HANG.
     // Jika berani, ubah kembali ke 100000000 (100MB).
-    const int TEXT_LENGTH = 100000; 
+    const size_t TEXT_LENGTH = 100000; 
     const int PATTERN_REPEAT_COUNT = 1000; 
     const string MOTIF = "CAG"; 
     
@@ -151,8 +241,8 @@ int main() {
     // Membuat Text
     string text;
     text.reserve(TEXT_LENGTH);
-    while (text.length() < TEXT_LENGTH) text += MOTIF;
-    text = text.substr(0, TEXT_LENGTH);
+    // Potongan motif terakhir dipotong saat ditambahkan, jadi tidak perlu substr (salinan kedua)
+    while (text.length() < TEXT_LENGTH) text.append(MOTIF, 0, min(MOTIF.length(), TEXT_LENGTH - text.length()));
 
     // 2. Cek System RAM Setelah Load Data
     long memLoaded = getPeakRSS();
@@ -197,7 +287,34 @@ int main() {
          << setw(12) << resKMP.stackMem 
          << setw(12) << resKMP.totalMem << endl;
 
+    // --- EXECUTE NAIVE & KMP (PACKED 2-BIT) ---
+    PackedSeq packedText = packSequence(text);
+    PackedSeq packedPattern = packSequence(pattern);
+    long memPacked = getPeakRSS();
+
+    AnalysisResult resNaive2b = naiveSearchPacked(packedText, packedPattern);
+    cout << left << setw(8) << resNaive2b.algorithm 
+         << setw(15) << resNaive2b.comparisons 
+         << setw(10) << resNaive2b.duration 
+         << "| "
+         << setw(12) << resNaive2b.inputMem 
+         << setw(12) << resNaive2b.lpsMem 
+         << setw(12) << resNaive2b.stackMem 
+         << setw(12) << resNaive2b.totalMem << endl;
+
+    AnalysisResult resKMP2b = KMPSearchPacked(packedText, packedPattern, pattern);
+    cout << left << setw(8) << resKMP2b.algorithm 
+         << setw(15) << resKMP2b.comparisons 
+         << setw(10) << resKMP2b.duration 
+         << "| "
+         << setw(12) << resKMP2b.inputMem 
+         << setw(12) << resKMP2b.lpsMem 
+         << setw(12) << resKMP2b.stackMem 
+         << setw(12) << resKMP2b.totalMem << endl;
+
     cout << "------------------------------------------------------------------------------------------------" << endl;
+    cout << "RSS After Pack  : " << memPacked << " KB (packed 2-bit: " << getPackedMemory(packedText)
+         << " Byte vs string: " << getStringMemory(text) << " Byte)" << endl;
     
     // Kesimpulan Logis
     cout << "\nKESIMPULAN LOGIS:" << endl;